@@ -0,0 +1,168 @@
+// conv.h with CONV_NO_ALLOC, built without exceptions. operator new is
+// replaced so that any allocation while a conversion runs fails the test.
+//   g++ -std=c++17 -fno-exceptions -ITestTo TestTo/TestNoAlloc.cpp -o TestNoAlloc && ./TestNoAlloc
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#define CONV_NO_ALLOC
+#include "conv.h"
+
+// set while the conversions under test run
+bool heap_forbidden = false;
+
+void* allocate(size_t size)
+{
+	if (heap_forbidden)
+	{
+		std::fprintf(stderr, "operator new(%zu) called by a conversion\n", size);
+		std::abort();
+	}
+	void* p = std::malloc(size != 0 ? size : 1);
+	if (!p)
+		std::abort();
+	return p;
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+// the std::basic_string output overloads are left out
+template<typename Str>
+auto formats_to(Str& str, int) -> decltype(conv::num_to_str(1, str), bool()) { return true; }
+template<typename Str>
+bool formats_to(Str&, long) { return false; }
+template<typename Str>
+auto float_formats_to(Str& str, int) -> decltype(conv::float_to_str(1.0, str), bool()) { return true; }
+template<typename Str>
+bool float_formats_to(Str&, long) { return false; }
+
+template<typename CharType>
+void test_parse(const CharType* text, long long expected)
+{
+	long long n = 0;
+	assert(conv::str_to_num(text, n) && n == expected);
+	const std::basic_string_view<CharType> view(text);
+	assert(conv::str_to_num(view, n) && n == expected);
+}
+
+template<typename CharType>
+void test_format(long long n, const char* expected)
+{
+	CharType buf[32];
+	assert(conv::num_to_str(n, buf, 32));
+	for (size_t i = 0; ; ++i)
+	{
+		assert(buf[i] == (CharType)expected[i]);
+		if (expected[i] == '\0')
+			break;
+	}
+	assert(conv::num_to_str<16>(n < 0 ? -n : n, buf, 32));
+	assert(!conv::num_to_str(n, buf, 1));
+}
+
+template<typename CharType>
+void test_float(double d, const char* expected)
+{
+	CharType buf[64];
+	assert(conv::float_to_str(d, buf, 64));
+	size_t i = 0;
+	for (; expected[i] != '\0'; ++i)
+		assert(buf[i] == (CharType)expected[i]);
+	assert(buf[i] == CharType());
+	double back = 0;
+	assert(conv::str_to_float(buf, back) && back == d);
+	assert(conv::float_to_str<std::chars_format::scientific>(d, buf, 64));
+	assert(!conv::float_to_str(d, buf, 2));
+}
+
+int main()
+{
+	// inputs built before the heap is closed
+	const std::string text = "-9223372036854775808";
+	const std::wstring wide_text = L"0x7FFFFFFF";
+	const std::wstring long_float(300, L'1');
+	const std::wstring small_float = L"0." + std::wstring(128, L'0') + L"1";
+
+	std::string out;
+	assert(!formats_to(out, 0) && !float_formats_to(out, 0));
+
+	heap_forbidden = true;
+
+	long long n = 0;
+	assert(conv::str_to_num(text, n) && n == INT64_MIN);
+	int h = 0;
+	assert(conv::str_to_num(wide_text, h, 16) && h == 0x7FFFFFFF);
+	assert(conv::str_to_num<16>(u"ff", h) && h == 255);
+	std::errc ec = std::errc();
+	assert(!conv::str_to_num("x12", h, 10, &ec) && ec == std::errc::invalid_argument);
+	test_parse("1234567", 1234567);
+	test_parse(L"-42", -42);
+	test_parse(U"7", 7);
+	const auto token = conv::parse<int>(L"-12;");
+	assert(token && token.value == -12 && *token.end == L';');
+
+	double d = 0;
+	assert(conv::str_to_float(L"2.5e-3", d) && d == 2.5e-3);
+	assert(conv::str_to_float(std::string_view("1e400"), d, std::chars_format::general, &ec) == false && ec == std::errc::result_out_of_range);
+	// a long wide float is read in place
+	assert(conv::str_to_float(long_float, d) && d == 1.1111111111111111e299);
+	assert(conv::str_to_float(small_float, d) && d == 1e-129);
+
+	test_format<char>(-1234567890123LL, "-1234567890123");
+	test_format<wchar_t>(INT64_MAX, "9223372036854775807");
+	test_format<char16_t>(0, "0");
+	test_float<char>(0.1, "0.1");
+	test_float<wchar_t>(-1.5e300, "-1.5e+300");
+
+	const auto fixed = conv::to_str_fixed(-2.25);
+	assert(fixed.view() == "-2.25");
+	assert(conv::to_str_fixed(UINT64_MAX).view() == "18446744073709551615");
+
+	const conv::punctuation euro = { '.', ',' };
+	char grouped[32];
+	assert(conv::num_to_str(-1234567, grouped, sizeof(grouped), euro) && std::strcmp(grouped, "-1.234.567") == 0);
+	assert(conv::float_to_str(1234.5, grouped, sizeof(grouped), euro) && std::strcmp(grouped, "1.234,5") == 0);
+	assert(conv::str_to_num(L"1.234.567", n, euro) && n == 1234567);
+	assert(conv::str_to_float("1.234,5", d, euro) && d == 1234.5);
+
+	int64_t cents = 0;
+	assert(conv::str_to_decimal(L"-123.455", cents, 2, conv::rounding::half_up) && cents == -12346);
+	assert(conv::decimal_to_str(cents, 2, grouped, sizeof(grouped)) && std::strcmp(grouped, "-123.46") == 0);
+
+	// batches into arrays
+	const int nums[] = { 1, -20, 300 };
+	char joined[32];
+	assert(conv::num_to_str_batch(nums, 3, ',', joined, sizeof(joined)).ec == std::errc() && std::strcmp(joined, "1,-20,300") == 0);
+	int parsed[3] = {};
+	assert(conv::str_to_num_delimited("4, 5,6", ", ", parsed, 3).count == 3 && parsed[2] == 6);
+	const std::string_view fields[] = { "8", "x", "10" };
+	std::errc ecs[3];
+	assert(conv::str_to_num_batch(fields, parsed, 3, 10, ecs) == 1 && ecs[1] == std::errc::invalid_argument);
+
+	conv::incremental_parser<int> parser;
+	int sum = 0;
+	assert(parser.feed("12,3", [&sum](int v) { sum += v; }) && parser.feed("4,", [&sum](int v) { sum += v; }));
+	assert(sum == 12 + 34);
+
+	char line[64];
+	conv::writer w(line, sizeof(line));
+	assert(w.write(42) && w.write(',') && w.write(0.5) && w.write(L"wide") && w.view() == "42,0.5wide");
+	char* end = conv::format_to(line, 255, 16);
+	assert(end - line == 2 && line[0] == 'F');
+
+	using namespace conv_literals;
+	assert(conv::from_literal<int>("0x1F", "0x1F" + 4) == 31 && 0b101_u8 == 5);
+
+	heap_forbidden = false;
+	std::printf("No allocation tests done.\n");
+	return 0;
+}
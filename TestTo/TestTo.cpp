@@ -1,5 +1,16 @@
 #include <iostream>
 #include <cassert>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <iterator>
+#include <sstream>
+#define CONV_ENABLE_PARALLEL
+#define CONV_ENABLE_AVX2
+#define CONV_ENABLE_PMR
+#define CONV_ENABLE_STATS
 #include "conv.h"
 
 using namespace std;
@@ -34,13 +45,138 @@ void test_str_to_num(const CharType* src, NumType answer, int base = 10)
 	assert(n == answer);
 }
 
+// str_to_num() must agree with from_chars() on value, errc and failure
+template<typename NumType>
+void test_str_to_num_from_chars(const char* src, int base = 10)
+{
+	NumType n = 7;
+	NumType expected = 7;
+	std::errc ec = std::errc::io_error;
+	auto ret = std::from_chars(src, src + strlen(src), expected, base);
+	assert(conv::str_to_num(src, n, base, &ec) == (ret.ec == std::errc()));
+	assert(ec == ret.ec);
+	assert(n == expected);
+}
+
+template<typename NumType>
+void test_str_to_float(const char* src, NumType answer, std::chars_format fmt = std::chars_format::general)
+{
+	NumType n = 7;
+	assert(conv::str_to_float(src, n, fmt));
+	assert(n == answer && std::signbit(n) == std::signbit(answer));
+
+	n = 7;
+	assert(conv::str_to_float(std::wstring(src, src + strlen(src)), n, fmt));
+	assert(n == answer);
+}
+
+template<typename NumType>
+void test_str_to_float_error(const char* src, std::errc error, std::chars_format fmt = std::chars_format::general)
+{
+	NumType n = 7;
+	std::errc ec = std::errc();
+	assert(!conv::str_to_float(src, n, fmt, &ec));
+	assert(ec == error && n == 7);
+}
+
+// str_to_float() must agree with from_chars() on value, errc and failure
+template<typename NumType>
+void test_str_to_float_from_chars(const std::string& src, std::chars_format fmt)
+{
+#if defined(__cpp_lib_to_chars)
+	NumType n = 7;
+	NumType expected = 7;
+	std::errc ec = std::errc::io_error;
+	auto ret = std::from_chars(src.data(), src.data() + src.size(), expected, fmt);
+	assert(conv::str_to_float(src, n, fmt, &ec) == (ret.ec == std::errc()));
+	assert(ec == ret.ec);
+	assert(memcmp(&n, &expected, sizeof(n)) == 0 || (n != n && expected != expected));
+#else
+	(void)src;
+	(void)fmt;
+#endif
+}
+
+template<typename NumType, typename CharType>
+void test_float_to_str(NumType n, const CharType* answer, std::chars_format fmt = std::chars_format::general)
+{
+	std::basic_string<CharType> s;
+	assert(conv::float_to_str(n, s, fmt));
+	assert(s == answer);
+
+	CharType buf[400];
+	assert(conv::float_to_str(n, buf, 400, fmt));
+	assert(s == buf);
+	assert(!conv::float_to_str(n, buf, s.size(), fmt));
+}
+
+// the shortest text reads back to the same float in every format
+template<typename NumType>
+void test_float_round_trip(NumType n)
+{
+	for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+	{
+		std::string s;
+		assert(conv::float_to_str(n, s, fmt));
+		NumType back = 0;
+		assert(conv::str_to_float(s, back, fmt));
+		assert(memcmp(&back, &n, sizeof(n)) == 0);
+	}
+}
+
 void test_num_to_str_list();
 void test_str_to_num_list();
+void test_str_to_num_dec_list();
+void test_num_radix_list();
+void test_num_to_str_dec_list();
+void test_str_to_float_list();
+void test_float_to_str_list();
+void test_str_to_num_batch_list();
+void test_num_to_str_batch_list();
+void test_append_list();
+void test_allocator_list();
+void test_stats_list();
+void test_to_str_fixed_list();
+void test_constexpr_list();
+void test_template_base_list();
+void test_parse_list();
+void test_classify_list();
+void test_punctuation_list();
+void test_decimal_list();
+void test_str_to_num_delimited_list();
+void test_incremental_parser_list();
+void test_load_numbers_list();
+void test_str_to_num_parallel_list();
+void test_str_to_num_wide_list();
+void test_num_types_list();
 
 int main()
 {
 	test_num_to_str_list();
 	test_str_to_num_list();
+	test_str_to_num_dec_list();
+	test_num_radix_list();
+	test_num_to_str_dec_list();
+	test_str_to_float_list();
+	test_float_to_str_list();
+	test_str_to_num_batch_list();
+	test_num_to_str_batch_list();
+	test_append_list();
+	test_allocator_list();
+	test_stats_list();
+	test_to_str_fixed_list();
+	test_constexpr_list();
+	test_template_base_list();
+	test_parse_list();
+	test_classify_list();
+	test_punctuation_list();
+	test_decimal_list();
+	test_str_to_num_delimited_list();
+	test_incremental_parser_list();
+	test_load_numbers_list();
+	test_str_to_num_parallel_list();
+	test_str_to_num_wide_list();
+	test_num_types_list();
 
 	std::cout << "Tests done." << std::endl;
 
@@ -340,3 +476,1938 @@ void test_str_to_num_list()
 	test_str_to_num<uint64_t, wchar_t, 40>(L"13102", 5698, 8);
 }
 
+template<typename NumType>
+void test_str_to_num_dec_type()
+{
+	const char* samples[] = {
+		"", "-", "+1", " 1", "a1", "0", "-0", "7", "-7", "12abc", "-12-3",
+		"255", "256", "-128", "-129", "32767", "32768", "-32768", "-32769", "65535", "65536",
+		"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+		"12345678", "123456789012", "1234567890123456", "12345678901234567", "-1234567890123456789",
+		"9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+		"18446744073709551615", "18446744073709551616", "18446744073709551625", "99999999999999999999",
+		"184467440737095516150", "00000000000000000000000000000000000000042",
+		"0000000000000000000000000000018446744073709551615",
+		"-000000000000000000000000000000009223372036854775808",
+		"1234567890123456789x", "123456789012345678901234567890123456789",
+	};
+	for (const char* src : samples)
+		test_str_to_num_from_chars<NumType>(src);
+
+	// every digit count up to the vector widths and past them
+	std::string digits;
+	for (int i = 0; i < 40; ++i)
+	{
+		digits += (char)('1' + i % 9);
+		test_str_to_num_from_chars<NumType>(digits.c_str());
+		test_str_to_num_from_chars<NumType>(("-" + digits).c_str());
+		test_str_to_num_from_chars<NumType>((digits + ",5").c_str());
+	}
+}
+
+void test_str_to_float_list()
+{
+	// correctly rounded at the edges of double
+	test_str_to_float<double>("0.1", 0.1);
+	test_str_to_float<double>("1e23", 1e23);
+	test_str_to_float<double>("-0", -0.0);
+	test_str_to_float<double>("1.7976931348623157e308", (std::numeric_limits<double>::max)());
+	test_str_to_float<double>("2.2250738585072011e-308", 0x0.fffffffffffffp-1022);
+	test_str_to_float<double>("2.2250738585072014e-308", (std::numeric_limits<double>::min)());
+	test_str_to_float<double>("4.9e-324", std::numeric_limits<double>::denorm_min());
+	test_str_to_float<double>("3e-324", std::numeric_limits<double>::denorm_min());
+	test_str_to_float<double>("9007199254740993", 9007199254740992.0);
+	test_str_to_float<double>("9007199254740993.0000000000000000000001", 9007199254740994.0);
+	test_str_to_float<double>("9007199254740995", 9007199254740996.0);
+	test_str_to_float<double>("0.000000000000000000000000000000000000000000001e45", 1.0);
+	test_str_to_float<double>("0e999999999999", 0.0);
+	test_str_to_float_error<double>("1.7976931348623159e308", std::errc::result_out_of_range);
+	test_str_to_float_error<double>("2e-324", std::errc::result_out_of_range);
+	test_str_to_float_error<double>("1e99999999999999999999", std::errc::result_out_of_range);
+	test_str_to_float_error<double>("-1e-99999999999999999999", std::errc::result_out_of_range);
+
+	// and of float
+	test_str_to_float<float>("16777217", 16777216.0f);
+	test_str_to_float<float>("3.4028235e38", (std::numeric_limits<float>::max)());
+	test_str_to_float<float>("1e-45", std::numeric_limits<float>::denorm_min());
+	// 2^-150 is halfway between 0 and the smallest subnormal float
+	const std::string half_min = "7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46";
+	test_str_to_float<float>((half_min.substr(0, half_min.size() - 4) + "1e-46").c_str(), std::numeric_limits<float>::denorm_min());
+	test_str_to_float_error<float>(half_min.c_str(), std::errc::result_out_of_range);
+	test_str_to_float_error<float>("3.4028236e38", std::errc::result_out_of_range);
+	test_str_to_float_error<float>("1e-46", std::errc::result_out_of_range);
+
+	// a digit past the 800 the exact fallback keeps decides the rounding
+	std::string halfway = "9007199254740993." + std::string(900, '0');
+	test_str_to_float<double>(halfway.c_str(), 9007199254740992.0);
+	test_str_to_float<double>((halfway + "1").c_str(), 9007199254740994.0);
+
+	// every chars_format, trailing characters are not parsed
+	test_str_to_float<double>("1e5", 1.0, std::chars_format::fixed);
+	test_str_to_float<double>("1.25", 1.25, std::chars_format::fixed);
+	test_str_to_float<double>("1.5e2", 150.0, std::chars_format::scientific);
+	test_str_to_float_error<double>("1.5", std::errc::invalid_argument, std::chars_format::scientific);
+	test_str_to_float_error<double>("1e+", std::errc::invalid_argument, std::chars_format::scientific);
+	test_str_to_float<double>("1e+", 1.0);
+	test_str_to_float<double>("1.8p1", 3.0, std::chars_format::hex);
+	test_str_to_float<double>("-1.8P-1", -0.75, std::chars_format::hex);
+	test_str_to_float<double>("1e4", 0x1e4, std::chars_format::hex);
+	test_str_to_float<double>("1p-1074", std::numeric_limits<double>::denorm_min(), std::chars_format::hex);
+	test_str_to_float<double>("1.fffffffffffffp1023", (std::numeric_limits<double>::max)(), std::chars_format::hex);
+	test_str_to_float<double>("0x1p3", 0.0, std::chars_format::hex);
+	test_str_to_float<float>("1.fffffep127", (std::numeric_limits<float>::max)(), std::chars_format::hex);
+	test_str_to_float_error<double>("1p-1075", std::errc::result_out_of_range, std::chars_format::hex);
+	test_str_to_float_error<float>("1.ffffffp127", std::errc::result_out_of_range, std::chars_format::hex);
+	test_str_to_float_error<double>("1.fffffffffffff8p1023", std::errc::result_out_of_range, std::chars_format::hex);
+	for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+	{
+		double d = 0;
+		assert(conv::str_to_float("-Infinity", d, fmt) && d == -std::numeric_limits<double>::infinity());
+		assert(conv::str_to_float("nan(snan_1)", d, fmt) && d != d);
+		test_str_to_float_error<double>(".", std::errc::invalid_argument, fmt);
+		test_str_to_float_error<double>("+1", std::errc::invalid_argument, fmt);
+	}
+
+	const char* samples[] = {
+		"", "-", ".", ".5", "5.", "-.5e1", "1e", "1ee", "1e+5x", "e5", " 1", "+1", "0x1p3",
+		"inf", "-INF", "infinit", "infinityx", "nan", "-nan(123)", "nan(12 3)", "nan(",
+		"123456789012345678901234567890", "0.30000000000000004", "4.4501477170144023e-308",
+		"2.4703282292062327e-324", "2.4703282292062328e-324", "1.5e-99999999999999999999",
+		"ffp", "1E5", "1.8p1", "1.5e99999999999999999999",
+	};
+	std::mt19937_64 rng(2024);
+	std::vector<std::string> srcs(std::begin(samples), std::end(samples));
+	char buf[64];
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::uint64_t bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		snprintf(buf, sizeof(buf), "%.*g", (int)(rng() % 18) + 1, d);
+		srcs.push_back(buf);
+		snprintf(buf, sizeof(buf), "%a", d);
+		srcs.push_back(buf[0] == '-' ? std::string("-") + (buf + 3) : std::string(buf + 2));
+	}
+	for (const std::string& src : srcs)
+	{
+		for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+		{
+			test_str_to_float_from_chars<float>(src, fmt);
+			test_str_to_float_from_chars<double>(src, fmt);
+		}
+	}
+}
+
+void test_float_to_str_list()
+{
+	test_float_to_str<double, char>(0.1, "0.1");
+	test_float_to_str<double, char>(-0.0, "-0");
+	test_float_to_str<double, char>(123.456, "123.456");
+	test_float_to_str<double, char>(123456.0, "123456");
+	test_float_to_str<double, char>(1234567.0, "1.234567e+06");
+	test_float_to_str<double, char>(0.0001, "0.0001");
+	test_float_to_str<double, char>(0.00001, "1e-05");
+	test_float_to_str<double, char>(5e-324, "5e-324");
+	test_float_to_str<double, char>(1.7976931348623157e308, "1.7976931348623157e+308");
+	test_float_to_str<double, wchar_t>(0.3, L"0.3");
+	test_float_to_str<float, char>(0.1f, "0.1");
+	test_float_to_str<float, char>(16777216.0f, "1.6777216e+07");
+	test_float_to_str<float, wchar_t>(3.4028235e38f, L"3.4028235e+38");
+
+	test_float_to_str<double, char>(0.0, "0", std::chars_format::fixed);
+	test_float_to_str<double, char>(1.2345e-5, "0.000012345", std::chars_format::fixed);
+	test_float_to_str<double, char>(1e22, "10000000000000000000000", std::chars_format::fixed);
+	// past 2^53 fixed writes the float exactly
+	test_float_to_str<double, char>(1e23, "99999999999999991611392", std::chars_format::fixed);
+	test_float_to_str<float, wchar_t>(1e10f, L"10000000000", std::chars_format::fixed);
+
+	test_float_to_str<double, char>(0.0, "0e+00", std::chars_format::scientific);
+	test_float_to_str<double, char>(1.5, "1.5e+00", std::chars_format::scientific);
+	test_float_to_str<double, wchar_t>(-1e300, L"-1e+300", std::chars_format::scientific);
+	test_float_to_str<float, char>(1e-45f, "1e-45", std::chars_format::scientific);
+
+	test_float_to_str<double, char>(1.5, "1.8p+0", std::chars_format::hex);
+	test_float_to_str<double, char>(0.1, "1.999999999999ap-4", std::chars_format::hex);
+	test_float_to_str<double, char>(5e-324, "0.0000000000001p-1022", std::chars_format::hex);
+	test_float_to_str<float, wchar_t>(0.1f, L"1.99999ap-4", std::chars_format::hex);
+	test_float_to_str<float, char>(-0.0f, "-0p+0", std::chars_format::hex);
+
+	for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+	{
+		test_float_to_str<double, char>(std::numeric_limits<double>::infinity(), "inf", fmt);
+		test_float_to_str<float, wchar_t>(-std::numeric_limits<float>::infinity(), L"-inf", fmt);
+		test_float_to_str<double, char>(std::numeric_limits<double>::quiet_NaN(), "nan", fmt);
+	}
+	assert(conv::to_str(2.5) == "2.5");
+	assert(conv::to_str(1e100) == "1e+100");
+
+	std::mt19937_64 rng(2025);
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::uint64_t bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		std::uint32_t fbits = (std::uint32_t)bits;
+		float f;
+		memcpy(&f, &fbits, sizeof(f));
+		if (d == d && d - d == 0)
+			test_float_round_trip(d);
+		if (f == f && f - f == 0)
+			test_float_round_trip(f);
+	}
+}
+
+void test_str_to_num_dec_list()
+{
+	test_str_to_num_dec_type<int16_t>();
+	test_str_to_num_dec_type<uint16_t>();
+	test_str_to_num_dec_type<int32_t>();
+	test_str_to_num_dec_type<uint32_t>();
+	test_str_to_num_dec_type<int64_t>();
+	test_str_to_num_dec_type<uint64_t>();
+}
+
+template<typename NumType, typename CharType, int len>
+void test_num_to_str_case(NumType n, const CharType* answer, int base, conv::digit_case letters)
+{
+	std::basic_string<CharType> s;
+	assert(conv::num_to_str(n, s, base, letters));
+	assert(s == answer);
+
+	CharType buf[len];
+	assert(conv::num_to_str(n, buf, len, base, letters));
+	assert(s == buf);
+}
+
+// the power of two bases must write what to_chars() writes, in an exact
+// sized buffer and not one character less, and parse it back
+template<typename NumType>
+void test_num_radix_type()
+{
+	std::mt19937_64 rng(2024);
+	for (int i = 0; i < 20000; ++i)
+	{
+		NumType n = (NumType)(rng() >> (rng() % 64));
+		if (i < 64)
+			n = (NumType)(std::numeric_limits<NumType>::min() + i);
+		else if (i < 128)
+			n = (NumType)(std::numeric_limits<NumType>::max() - (i - 64));
+		for (int base : { 2, 4, 8, 16, 32 })
+		{
+			char expected[72];
+			auto ret = std::to_chars(expected, expected + sizeof(expected), n, base);
+			*ret.ptr = '\0';
+			const size_t length = (size_t)(ret.ptr - expected);
+
+			char buf[72];
+			assert(conv::num_to_str(n, buf, length + 1, base));
+			assert(strcmp(buf, expected) == 0);
+			assert(!conv::num_to_str(n, buf, length, base));
+
+			NumType back = 0;
+			assert(conv::str_to_num(std::string_view(expected, length), back, base));
+			assert(back == n);
+			test_str_to_num_from_chars<NumType>(expected, base);
+		}
+	}
+
+	const char* samples[] = {
+		"", "-", "+1", "-0", "0", "000000000000000000000000000000000000000000000000000000000000000000000001",
+		"1111111111111111111111111111111111111111111111111111111111111111",
+		"10000000000000000000000000000000000000000000000000000000000000000",
+		"-1000000000000000000000000000000000000000000000000000000000000000",
+		"-1000000000000000000000000000000000000000000000000000000000000001",
+		"7fff", "8000", "-8000", "-8001", "ffff", "10000", "FfFf", "7fffffff", "80000000", "-80000000",
+		"ffffffff", "100000000", "7fffffffffffffff", "8000000000000000", "-8000000000000000",
+		"ffffffffffffffff", "10000000000000000", "1ffffffffffffffff", "0000000000000000000000ffffffffffffffff",
+		"zz", "vv", "VVVV", "fvvvvvvvvvvvv", "1vvvvvvvvvvvvv", "g0", "12g", "0x1F", "1777777777777777777777",
+		"2000000000000000000000", "3333333333333333333333333333333", "33333333333333333333333333333333",
+	};
+	for (const char* src : samples)
+	{
+		for (int base : { 2, 4, 8, 16, 32 })
+		{
+			if (base != 16 || strncmp(src, "0x", 2) != 0)
+				test_str_to_num_from_chars<NumType>(src, base);
+		}
+	}
+}
+
+void test_num_radix_list()
+{
+	test_num_radix_type<int8_t>();
+	test_num_radix_type<uint8_t>();
+	test_num_radix_type<int16_t>();
+	test_num_radix_type<uint16_t>();
+	test_num_radix_type<int32_t>();
+	test_num_radix_type<uint32_t>();
+	test_num_radix_type<int64_t>();
+	test_num_radix_type<uint64_t>();
+
+	test_num_to_str_case<uint32_t, char, 40>(0xDEADBEEF, "deadbeef", 16, conv::digit_case::lower);
+	test_num_to_str_case<uint32_t, wchar_t, 40>(0xDEADBEEF, L"DEADBEEF", 16, conv::digit_case::upper);
+	test_num_to_str_case<uint64_t, char, 40>(0x0123456789ABCDEFull, "123456789abcdef", 16, conv::digit_case::lower);
+	test_num_to_str_case<uint64_t, char, 40>(0xFEDCBA9876543210ull, "FEDCBA9876543210", 16, conv::digit_case::upper);
+	test_num_to_str_case<uint32_t, char, 40>(0, "0", 16, conv::digit_case::upper);
+	test_num_to_str_case<uint16_t, char, 20>(5698, "1011001000010", 2, conv::digit_case::lower);
+	test_num_to_str_case<uint16_t, char, 20>(5698, "1121002", 4, conv::digit_case::lower);
+	test_num_to_str_case<uint16_t, char, 20>(5698, "5i2", 32, conv::digit_case::lower);
+	test_num_to_str_case<uint16_t, char16_t, 20>(5698, u"5I2", 32, conv::digit_case::upper);
+	test_num_to_str_case<uint64_t, char, 80>(UINT64_MAX, "1111111111111111111111111111111111111111111111111111111111111111", 2, conv::digit_case::lower);
+	test_num_to_str_case<uint64_t, char, 40>(UINT64_MAX, "FVVVVVVVVVVVV", 32, conv::digit_case::upper);
+
+	// the string overloads write a negative number as two's complement,
+	// the array overloads as a sign and magnitude
+	std::string s;
+	assert(conv::num_to_str(0xDEADBEEF, s, 16) && s == "DEADBEEF");
+	assert(conv::num_to_str((int16_t)-2, s, 16) && s == "FFFFFFFE");
+	assert(conv::num_to_str((int64_t)-2, s, 2, conv::digit_case::lower) && s == std::string(63, '1') + "0");
+	char buf[40];
+	assert(conv::num_to_str((int16_t)-2, buf, sizeof(buf), 16) && strcmp(buf, "-2") == 0);
+	assert(conv::num_to_str(INT64_MIN, buf, sizeof(buf), 16, conv::digit_case::upper) && strcmp(buf, "-8000000000000000") == 0);
+
+	// other bases up to 36 in the array overloads
+	assert(conv::num_to_str(1295, buf, sizeof(buf), 36, conv::digit_case::upper) && strcmp(buf, "ZZ") == 0);
+	assert(conv::num_to_str(1295, buf, sizeof(buf), 36) && strcmp(buf, "zz") == 0);
+	assert(!conv::num_to_str(1295, s, 36));
+
+	uint32_t n = 0;
+	assert(conv::str_to_num("DeadBeef", n, 16) && n == 0xDEADBEEF);
+	assert(conv::str_to_num("0XdeadBEEF", n, 16) && n == 0xDEADBEEF);
+	assert(conv::str_to_num(u"5I2", n, 32) && n == 5698);
+	assert(conv::str_to_num(L"1011001000010", n, 2) && n == 5698);
+}
+
+// the digit pair formatter must write what to_chars() writes, then one
+// terminator, and leave the rest of the buffer alone
+template<typename NumType, typename CharType>
+void test_num_to_str_dec(NumType n)
+{
+	char expected[24];
+	auto ret = std::to_chars(expected, expected + sizeof(expected), n);
+	const size_t length = (size_t)(ret.ptr - expected);
+
+	CharType buf[32];
+	std::fill(std::begin(buf), std::end(buf), (CharType)'#');
+	assert(conv::num_to_str(n, buf, length + 1));
+	for (size_t i = 0; i < length; ++i)
+		assert(buf[i] == (CharType)expected[i]);
+	assert(buf[length] == 0);
+	for (size_t i = length + 1; i < std::size(buf); ++i)
+		assert(buf[i] == (CharType)'#');
+
+	// too small, the buffer is an empty string
+	assert(!conv::num_to_str(n, buf, length));
+	assert(buf[0] == 0);
+
+	std::basic_string<CharType> s;
+	assert(conv::num_to_str(n, s));
+	assert(s.size() == length && s == std::basic_string<CharType>(expected, expected + length));
+}
+
+template<typename NumType>
+void test_num_to_str_dec_type()
+{
+	// both sides of every power of ten
+	for (NumType p = 1; ; p = (NumType)(p * 10))
+	{
+		test_num_to_str_dec<NumType, char>(p);
+		test_num_to_str_dec<NumType, char>((NumType)(p - 1));
+		test_num_to_str_dec<NumType, wchar_t>((NumType)(p + 1));
+		if constexpr (std::is_signed_v<NumType>)
+			test_num_to_str_dec<NumType, char>((NumType)-p);
+		if (p > std::numeric_limits<NumType>::max() / 10)
+			break;
+	}
+	test_num_to_str_dec<NumType, char>(std::numeric_limits<NumType>::min());
+	test_num_to_str_dec<NumType, char>(std::numeric_limits<NumType>::max());
+	test_num_to_str_dec<NumType, char16_t>(std::numeric_limits<NumType>::max());
+
+	std::mt19937_64 rng(77);
+	for (int i = 0; i < 20000; ++i)
+		test_num_to_str_dec<NumType, char>((NumType)(rng() >> (rng() % 64)));
+}
+
+void test_num_to_str_dec_list()
+{
+	test_num_to_str_dec_type<int8_t>();
+	test_num_to_str_dec_type<uint8_t>();
+	test_num_to_str_dec_type<int16_t>();
+	test_num_to_str_dec_type<uint16_t>();
+	test_num_to_str_dec_type<int32_t>();
+	test_num_to_str_dec_type<uint32_t>();
+	test_num_to_str_dec_type<int64_t>();
+	test_num_to_str_dec_type<uint64_t>();
+}
+
+template<typename NumType>
+void test_str_to_num_batch(int base)
+{
+	const std::string_view strs[] = { "12", "0x1F", "abc", "-5", "", "77", "99999999999999999999", "10" };
+	const size_t count = std::size(strs);
+	NumType nums[count] = {};
+	std::errc ecs[count];
+	size_t failures = conv::str_to_num_batch(strs, nums, count, base, ecs);
+
+	size_t expected_failures = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		NumType n = 0;
+		std::errc ec;
+		bool ok = conv::str_to_num(strs[i], n, base, &ec);
+		expected_failures += ok ? 0 : 1;
+		assert(ecs[i] == ec);
+		if (ok)
+			assert(nums[i] == n);
+	}
+	assert(failures == expected_failures);
+	assert(conv::str_to_num_batch(strs, nums, count, base) == expected_failures);
+}
+
+template<typename NumType>
+void test_str_to_float_batch()
+{
+	const std::string_view strs[] = { "1.5", "-2e3", "x", "0.1" };
+	NumType nums[4] = {};
+	std::errc ecs[4];
+	assert(conv::str_to_float_batch(strs, nums, 4, std::chars_format::general, ecs) == 1);
+	assert(nums[0] == (NumType)1.5 && nums[1] == (NumType)-2000 && nums[3] == (NumType)0.1);
+	assert(ecs[2] == std::errc::invalid_argument);
+}
+
+void test_str_to_num_batch_list()
+{
+	for (int base : { 10, 16, 8 })
+	{
+		test_str_to_num_batch<int16_t>(base);
+		test_str_to_num_batch<uint16_t>(base);
+		test_str_to_num_batch<int32_t>(base);
+		test_str_to_num_batch<uint32_t>(base);
+		test_str_to_num_batch<int64_t>(base);
+		test_str_to_num_batch<uint64_t>(base);
+	}
+	test_str_to_float_batch<float>();
+	test_str_to_float_batch<double>();
+
+#ifdef CONV_HAS_SPAN
+	std::vector<std::string_view> column = { "1", "2", "x", "4" };
+	std::vector<int32_t> values(column.size());
+	std::vector<std::errc> ecs(column.size());
+	assert(conv::str_to_num_batch(column, std::span<int32_t>(values), 10, ecs) == 1);
+	assert(values[3] == 4 && ecs[2] == std::errc::invalid_argument);
+#endif
+}
+
+// the batch text is the text of each value from num_to_str() or
+// float_to_str() joined by the delimiter
+template<typename NumType, typename Format>
+std::string join_text(const std::vector<NumType>& nums, char delim, std::vector<size_t>& offsets, Format format)
+{
+	std::string text;
+	offsets.clear();
+	for (NumType n : nums)
+	{
+		if (!offsets.empty())
+			text += delim;
+		offsets.push_back(text.size());
+		char buf[400];
+		assert(format(n, buf));
+		text += buf;
+	}
+	return text;
+}
+
+template<typename NumType>
+void test_num_to_str_batch(int base)
+{
+	std::vector<NumType> nums = { 0, 1, 9, 10, 99, 100, (NumType)12345, std::numeric_limits<NumType>::max(), std::numeric_limits<NumType>::min() };
+	if constexpr (std::is_signed_v<NumType>)
+		nums.insert(nums.end(), { -1, -10, -99, (NumType)-12345 });
+	std::mt19937_64 rng(99);
+	for (int i = 0; i < 1000; ++i)
+		nums.push_back((NumType)(rng() >> (rng() % 64)));
+
+	std::vector<size_t> expected_offsets;
+	const std::string expected = join_text(nums, ',', expected_offsets, [base](NumType n, char* buf) {
+		return conv::num_to_str(n, buf, 400, base);
+	});
+
+	std::vector<char> buf(expected.size() + 1, '#');
+	std::vector<size_t> offsets(nums.size());
+	auto ret = conv::num_to_str_batch(nums.data(), nums.size(), ',', buf.data(), buf.size(), base, offsets.data());
+	assert(ret.count == nums.size() && ret.offset == expected.size() && ret.ec == std::errc());
+	assert(buf.data() == expected && offsets == expected_offsets);
+
+	std::string str;
+	std::fill(offsets.begin(), offsets.end(), 0);
+	assert(conv::num_to_str_batch(nums.data(), nums.size(), ',', str, base, offsets.data()));
+	assert(str == expected && offsets == expected_offsets);
+
+	// one character short: every value but the last, terminated
+	ret = conv::num_to_str_batch(nums.data(), nums.size(), ',', buf.data(), buf.size() - 1, base);
+	assert(ret.count == nums.size() - 1 && ret.ec == std::errc::value_too_large);
+	assert(ret.offset == expected_offsets.back() - 1 && buf[ret.offset] == '\0');
+	assert(expected.compare(0, ret.offset, buf.data()) == 0);
+
+#ifdef CONV_ENABLE_PARALLEL
+	std::vector<NumType> many(300000);
+	for (NumType& n : many)
+		n = (NumType)(rng() >> (rng() % 64));
+	std::string serial;
+	std::vector<size_t> serial_offsets(many.size());
+	assert(conv::num_to_str_batch(many.data(), many.size(), '\n', serial, base, serial_offsets.data()));
+	for (unsigned threads : { 1u, 3u, 8u, 0u })
+	{
+		std::string parallel;
+		std::vector<size_t> parallel_offsets(many.size());
+		assert(conv::num_to_str_parallel(many.data(), many.size(), '\n', parallel, base, threads, parallel_offsets.data()));
+		assert(parallel == serial && parallel_offsets == serial_offsets);
+	}
+#endif
+}
+
+template<typename NumType>
+void test_float_to_str_batch(std::chars_format fmt)
+{
+	std::vector<NumType> nums = { 0, -0.0f, 1, 0.1f, -2.5f, 1e30f, 1e-30f, std::numeric_limits<NumType>::max(),
+		std::numeric_limits<NumType>::denorm_min(), std::numeric_limits<NumType>::infinity() };
+	std::mt19937_64 rng(7);
+	for (int i = 0; i < 1000; ++i)
+		nums.push_back((NumType)std::uniform_real_distribution<double>(-1e6, 1e6)(rng));
+
+	std::vector<size_t> expected_offsets;
+	const std::string expected = join_text(nums, ';', expected_offsets, [fmt](NumType n, char* buf) {
+		return conv::float_to_str(n, buf, 400, fmt);
+	});
+
+	std::vector<char> buf(expected.size() + 1);
+	std::vector<size_t> offsets(nums.size());
+	auto ret = conv::float_to_str_batch(nums.data(), nums.size(), ';', buf.data(), buf.size(), fmt, offsets.data());
+	assert(ret.count == nums.size() && ret.offset == expected.size() && ret.ec == std::errc());
+	assert(buf.data() == expected && offsets == expected_offsets);
+
+	// the string starts short of a fixed notation DBL_MAX and grows
+	std::string str;
+	assert(conv::float_to_str_batch(nums.data(), nums.size(), ';', str, fmt, offsets.data()));
+	assert(str == expected && offsets == expected_offsets);
+
+#ifdef CONV_ENABLE_PARALLEL
+	std::vector<NumType> many(200000);
+	for (NumType& n : many)
+		n = (NumType)std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+	std::string serial;
+	std::vector<size_t> serial_offsets(many.size());
+	assert(conv::float_to_str_batch(many.data(), many.size(), ',', serial, fmt, serial_offsets.data()));
+	std::string parallel;
+	std::vector<size_t> parallel_offsets(many.size());
+	assert(conv::float_to_str_parallel(many.data(), many.size(), ',', parallel, fmt, 3, parallel_offsets.data()));
+	assert(parallel == serial && parallel_offsets == serial_offsets);
+#endif
+}
+
+void test_num_to_str_batch_list()
+{
+	for (int base : { 10, 16, 2, 36 })
+	{
+		test_num_to_str_batch<int16_t>(base);
+		test_num_to_str_batch<uint16_t>(base);
+		test_num_to_str_batch<int32_t>(base);
+		test_num_to_str_batch<uint32_t>(base);
+		test_num_to_str_batch<int64_t>(base);
+		test_num_to_str_batch<uint64_t>(base);
+	}
+	for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+	{
+		test_float_to_str_batch<float>(fmt);
+		test_float_to_str_batch<double>(fmt);
+	}
+
+	const int32_t nums[] = { 1, -2, 3 };
+	char buf[16];
+	auto ret = conv::num_to_str_batch(nums, 3, ',', buf, sizeof(buf), 37);
+	assert(ret.count == 0 && ret.ec == std::errc::invalid_argument && buf[0] == '\0');
+	ret = conv::num_to_str_batch(nums, 0, ',', buf, sizeof(buf));
+	assert(ret.count == 0 && ret.offset == 0 && ret.ec == std::errc() && buf[0] == '\0');
+
+#ifdef CONV_HAS_SPAN
+	std::vector<int32_t> column = { 10, -20, 30 };
+	std::string str;
+	assert(conv::num_to_str_batch(column, '\t', str) && str == "10\t-20\t30");
+	std::vector<size_t> offsets(column.size());
+	ret = conv::num_to_str_batch(std::span<const int32_t>(column), ',', std::span<char>(buf), 10, offsets);
+	assert(ret.count == 3 && std::string_view(buf) == "10,-20,30" && offsets[2] == 7);
+	const double values[] = { 0.5, 2 };
+	assert(conv::float_to_str_batch(values, ' ', str) && str == "0.5 2");
+#endif
+}
+
+// append() adds what num_to_str() writes to a string, formatted_size()
+// predicts its length, and a string reserved to that never reallocates
+template<typename CharType, typename... Args>
+void test_append(const CharType* answer, size_t size, const Args&... args)
+{
+	const std::basic_string<CharType> prefix(3, (CharType)'>');
+	std::basic_string<CharType> s = prefix;
+	s.reserve(prefix.size() + size);
+	const CharType* data = s.data();
+	assert(conv::append(s, args...));
+	assert(s == prefix + answer && s.data() == data);
+
+	std::basic_string<CharType> out;
+	conv::format_to(std::back_inserter(out), args...);
+	assert(out == answer);
+}
+
+template<typename NumType>
+void test_append_int(NumType n, int base)
+{
+	std::string expected;
+	assert(conv::num_to_str(n, expected, base));
+	assert(conv::formatted_size(n, base) == expected.size());
+	test_append(expected.c_str(), conv::formatted_size(n, base), n, base);
+	test_append(std::wstring(expected.begin(), expected.end()).c_str(), conv::formatted_size(n, base), n, base);
+}
+
+template<typename NumType>
+void test_append_float(NumType n)
+{
+	for (std::chars_format fmt : { std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::hex })
+	{
+		std::string expected;
+		assert(conv::float_to_str(n, expected, fmt));
+		assert(conv::formatted_size(n, fmt) == expected.size());
+		test_append(expected.c_str(), expected.size(), n, fmt);
+	}
+	for (int precision : { 0, 3, 400 })
+	{
+		std::string expected;
+		assert(conv::float_to_str(n, expected, precision));
+		assert(conv::formatted_size(n, precision) == expected.size());
+		test_append(expected.c_str(), expected.size(), n, precision);
+	}
+}
+
+void test_append_list()
+{
+	static_assert(conv::formatted_size(0) == 1);
+	static_assert(conv::formatted_size(-12345) == 6);
+	static_assert(conv::formatted_size(UINT64_MAX) == 20);
+	static_assert(conv::formatted_size(INT64_MIN) == 20);
+	static_assert(conv::formatted_size(255, 16) == 2);
+	static_assert(conv::formatted_size((int8_t)-1, 16) == 8);
+	static_assert(conv::formatted_size(5698u, 32) == 3);
+	static_assert(conv::formatted_size(10, 36) == 0);
+	static_assert(conv::formatted_size(true) == 4);
+
+	std::mt19937_64 rng(5);
+	for (int i = 0; i < 2000; ++i)
+	{
+		const uint64_t bits = rng() >> (rng() % 64);
+		for (int base : { 10, 2, 8, 16, 32 })
+		{
+			test_append_int((int16_t)bits, base);
+			test_append_int((uint16_t)bits, base);
+			test_append_int((int32_t)bits, base);
+			test_append_int((uint32_t)bits, base);
+			test_append_int((int64_t)bits, base);
+			test_append_int(bits, base);
+		}
+	}
+	for (double d : { 0.0, -0.0, 1.0, 0.1, -2.5, 1e300, 5e-324, 123456.789 })
+	{
+		test_append_float(d);
+		test_append_float((float)d);
+	}
+
+	test_append("DEADBEEF", 8, 0xDEADBEEF, 16);
+	test_append("deadbeef", 8, 0xDEADBEEF, 16, conv::digit_case::lower);
+	test_append("true", conv::formatted_size(true), true);
+	test_append(L"false", conv::formatted_size(false), false);
+	test_append("x", conv::formatted_size('x'), 'x');
+	test_append("abc", conv::formatted_size("abc"), "abc");
+	test_append(L"abc", conv::formatted_size(std::string("abc")), std::string("abc"));
+	test_append("wide", conv::formatted_size(L"wide"), L"wide");
+	std::string s;
+	assert(!conv::append(s, 10, 36) && s.empty());
+
+	// a fixed writer keeps what fits and stays terminated
+	char buf[12];
+	conv::writer fixed(buf, sizeof(buf));
+	assert(fixed.write(-42) && fixed.write(',') && fixed.write(2.5) && fixed.write(' '));
+	assert(!fixed.write(123456789) && fixed.view() == "-42,2.5 ");
+	assert(fixed.write(255, 16, conv::digit_case::lower) && fixed.write(true) == false);
+	assert(fixed.size() == 10 && std::string_view(buf) == "-42,2.5 ff");
+	assert(fixed.write('!') && std::string_view(buf) == "-42,2.5 ff!" && !fixed.write('!'));
+
+	// a growable writer appends to the string
+	std::string line = "x=";
+	conv::writer grow(line);
+	assert(grow.write(1e300) && grow.write(' ') && grow.write(0.5f, std::chars_format::scientific) && grow.write(L" ok"));
+	assert(line == "x=1e+300 5e-01 ok" && grow.view() == line);
+
+	char arr[8];
+	*conv::format_to(arr, (int8_t)-128) = '\0';
+	assert(std::string_view(arr) == "-128");
+	// code units take the type of the iterator, as in the string overloads
+	const std::wstring wide_text = L"ab\x0141";
+	std::string narrow, expected_narrow;
+	conv::format_to(std::back_inserter(narrow), wide_text);
+	assert(conv::append(expected_narrow, wide_text) && narrow == expected_narrow && narrow == "abA");
+	std::u32string wide;
+	conv::format_to(conv::format_to(std::back_inserter(wide), u"\x0141"), 1.5);
+	assert(wide == U"\x0141" U"1.5");
+	std::ostringstream stream;
+	conv::format_to(conv::format_to(std::ostreambuf_iterator<char>(stream), -3), L"x\x0179");
+	assert(stream.str() == "-3xy");
+}
+
+template<typename FloatType>
+void test_to_str_fixed_float(FloatType f)
+{
+	const auto fixed = conv::to_str_fixed(f);
+	assert(fixed.size() <= fixed.capacity() && fixed.c_str()[fixed.size()] == '\0');
+	assert(std::string_view(fixed) == conv::to_str(f));
+}
+
+void test_to_str_fixed_list()
+{
+	static_assert(decltype(conv::to_str_fixed(uint64_t()))::capacity() == 20);
+	static_assert(decltype(conv::to_str_fixed(int64_t()))::capacity() == 20);
+	static_assert(decltype(conv::to_str_fixed(int16_t()))::capacity() == 6);
+	static_assert(decltype(conv::to_str_fixed(double()))::capacity() == 24);
+	static_assert(decltype(conv::to_str_fixed(float()))::capacity() == 15);
+	static_assert(std::is_trivially_copyable_v<conv::small_str<24>>);
+	static_assert(noexcept(conv::to_str_fixed(1.0)));
+	static_assert(conv::to_str_fixed(false).view() == "false");
+	static_assert(conv::to_str_fixed('q').view() == "q");
+
+	assert(conv::to_str_fixed(INT64_MIN).view() == "-9223372036854775808");
+	assert(conv::to_str_fixed(UINT64_MAX).view() == "18446744073709551615");
+	assert(std::string_view(conv::to_str_fixed(-2.2250738585072014e-308)) == "-2.2250738585072014e-308");
+	assert(std::string_view(conv::to_str_fixed(-0.00012345678901234567)) == "-0.00012345678901234567");
+
+	for (double d : { 0.0, -0.0, 1.0, -1e300, 5e-324, DBL_MAX, -DBL_MIN, HUGE_VAL, -HUGE_VAL, (double)NAN })
+	{
+		test_to_str_fixed_float(d);
+		test_to_str_fixed_float((float)d);
+	}
+	std::mt19937_64 rng(16);
+	for (int i = 0; i < 100000; ++i)
+	{
+		const uint64_t bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		test_to_str_fixed_float(d);
+		float f;
+		const uint32_t bits32 = (uint32_t)bits;
+		memcpy(&f, &bits32, sizeof(f));
+		test_to_str_fixed_float(f);
+	}
+}
+
+template<typename NumType, typename CharType>
+constexpr NumType parsed(const CharType* str, int base = 10, NumType failed = 0)
+{
+	NumType n = 0;
+	return conv::str_to_num(str, n, base) ? n : failed;
+}
+
+template<typename CharType>
+struct text_buf
+{
+	CharType buf[72] = {};
+};
+
+template<typename NumType, typename CharType = char>
+constexpr text_buf<CharType> formatted(NumType n, int base = 10, size_t len = 72)
+{
+	text_buf<CharType> text;
+	if (!conv::num_to_str(n, text.buf, len, base))
+		text.buf[1] = '!';
+	return text;
+}
+
+// a table built at compile time
+struct port_name
+{
+	uint16_t port;
+	text_buf<char> text;
+};
+
+constexpr port_name make_port(const char* str)
+{
+	const uint16_t port = parsed<uint16_t>(str);
+	return { port, formatted(port) };
+}
+
+constexpr port_name ports[] = { make_port("22"), make_port("80"), make_port("443"), make_port("65535") };
+
+void test_constexpr_list()
+{
+	using namespace conv_literals;
+
+	static_assert(parsed<int64_t>("-9223372036854775808") == INT64_MIN);
+	static_assert(parsed<int64_t>("-9223372036854775809", 10, 7) == 7);
+	static_assert(parsed<uint64_t>("18446744073709551615") == UINT64_MAX);
+	static_assert(parsed<uint64_t>("18446744073709551616", 10, 7) == 7);
+	static_assert(parsed<uint32_t>("-1", 10, 7) == 7);
+	static_assert(parsed<int32_t>("-", 10, 7) == 7);
+	static_assert(parsed<int32_t>("123abc") == 123);
+	static_assert(parsed<int32_t>("0x7FFFFFFF", 16) == INT32_MAX);
+	static_assert(parsed<int32_t>(L"-0x80000000", 16, 7) == 0);
+	static_assert(parsed<uint8_t>(u"11111111", 2) == 255);
+	static_assert(parsed<int16_t>(U"zz", 36) == 1295);
+	static_assert(parsed<int16_t>("10", 37, 7) == 7);
+	static_assert(std::string_view(formatted(INT64_MIN).buf) == "-9223372036854775808");
+	static_assert(std::string_view(formatted(-255, 16).buf) == "-ff");
+	static_assert(std::string_view(formatted(UINT64_MAX, 2).buf).size() == 64);
+	static_assert(std::string_view(formatted(35, 36).buf) == "z");
+	static_assert(std::wstring_view(formatted<int, wchar_t>(1234).buf) == L"1234");
+	static_assert(std::string_view(formatted(1234, 10, 4).buf) == "" && formatted(1234, 10, 4).buf[1] == '!');
+	static_assert(ports[2].port == 443 && std::string_view(ports[3].text.buf) == "65535");
+
+	static_assert(0x1F_u32 == 31u && 0b1010_u8 == 10 && 017_i16 == 15 && 1'000'000_i64 == 1000000);
+	static_assert(255_u8 == 255 && 18446744073709551615_u64 == UINT64_MAX);
+	static_assert("0x1F"_u32 == 31u && "-128"_i8 == -128 && "-0x8000'0000"_i32 == INT32_MIN);
+	static_assert(std::is_same_v<decltype(1_i64), int64_t> && std::is_same_v<decltype("1"_u16), uint16_t>);
+
+	// the same calls at run time
+	const std::string text = "-0x7f";
+	int8_t i8 = 0;
+	assert(conv::str_to_num(text.c_str() + 1, i8, 16) && i8 == 127);
+	assert(conv::str_to_num(text, i8, 16) && i8 == 0);
+	assert(conv::from_literal<int8_t>(text.data(), text.data() + text.size()) == -127);
+	bool thrown = false;
+	try {
+		(void)conv::from_literal<uint8_t>("256", "256" + 3);
+	}
+	catch (std::out_of_range&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+	// a ' only goes between two digits, as in C++
+	static_assert("0'7"_i32 == 7 && "1'0"_i32 == 10 && "0x1'F"_i32 == 31);
+	for (const char* bad : { "1''0", "10'", "'10", "-'10", "0x'1F", "0b'1", "1'x", "0'" })
+	{
+		thrown = false;
+		try {
+			(void)conv::from_literal<int>(bad, bad + strlen(bad));
+		}
+		catch (std::invalid_argument&)
+		{
+			thrown = true;
+		}
+		assert(thrown);
+	}
+	for (const port_name& entry : ports)
+		assert(conv::to_str(entry.port) == entry.text.buf);
+}
+
+// the base as a template argument gives the same text and numbers
+template<int Base, typename NumType>
+void test_template_base(NumType n)
+{
+	char buf[72], expected[72];
+	assert(conv::num_to_str<Base>(n, buf, sizeof(buf)));
+	assert(conv::num_to_str(n, expected, sizeof(expected), Base));
+	assert(std::string_view(buf) == expected);
+	assert(conv::num_to_str<Base>(n, buf, sizeof(buf), conv::digit_case::upper));
+	assert(conv::num_to_str(n, expected, sizeof(expected), Base, conv::digit_case::upper));
+	assert(std::string_view(buf) == expected);
+	assert(!conv::num_to_str<Base>(n, buf, 2) || std::string_view(buf).size() == 1);
+
+	if constexpr (Base == 10 || Base == 2 || Base == 4 || Base == 8 || Base == 16 || Base == 32)
+	{
+		std::string s, t;
+		assert(conv::num_to_str<Base>(n, s) && conv::num_to_str(n, t, Base) && s == t);
+		std::wstring ws;
+		assert(conv::num_to_str<Base>(n, ws, conv::digit_case::lower) && ws.size() == s.size());
+	}
+
+	NumType parsed = 0;
+	std::errc ec{};
+	assert(conv::str_to_num<Base>(expected, parsed, &ec) && parsed == n && ec == std::errc());
+	const std::wstring wide(expected, expected + strlen(expected));
+	parsed = 0;
+	assert(conv::str_to_num<Base>(wide, parsed) && parsed == n);
+	const std::string too_long(70, '1');
+	NumType before = parsed;
+	assert(!conv::str_to_num<Base>(too_long, parsed, &ec) && ec == std::errc::result_out_of_range && parsed == before);
+}
+
+template<int Base>
+void test_template_base_types(uint64_t bits)
+{
+	test_template_base<Base>((int8_t)bits);
+	test_template_base<Base>((uint8_t)bits);
+	test_template_base<Base>((int16_t)bits);
+	test_template_base<Base>((uint32_t)bits);
+	test_template_base<Base>((int64_t)bits);
+	test_template_base<Base>(bits);
+}
+
+template<std::chars_format Fmt, typename FloatType>
+void test_template_format(FloatType f)
+{
+	std::string s, t;
+	assert(conv::float_to_str<Fmt>(f, s) && conv::float_to_str(f, t, Fmt) && s == t);
+	wchar_t wbuf[400], wexpected[400];
+	assert(conv::float_to_str<Fmt>(f, wbuf, 400) && conv::float_to_str(f, wexpected, 400, Fmt));
+	assert(std::wstring_view(wbuf) == wexpected);
+
+	FloatType parsed = 0, expected = 0;
+	std::errc ec{}, expected_ec{};
+	const bool ok = conv::str_to_float<Fmt>(s, parsed, &ec);
+	assert(ok == conv::str_to_float(s, expected, Fmt, &expected_ec) && ec == expected_ec);
+	assert(!ok || f != f || parsed == expected);
+}
+
+void test_template_base_list()
+{
+	constexpr int hex = [] {
+		int n = 0;
+		return conv::str_to_num<16>("0x1F", n) ? n : -1;
+	}();
+	static_assert(hex == 31);
+	static_assert(std::string_view(formatted(-255, 16).buf) == [] {
+		text_buf<char> text;
+		return conv::num_to_str<16>(-255, text.buf, sizeof(text.buf)) ? text : text_buf<char>();
+	}().buf);
+	std::mt19937_64 rng(18);
+	for (int i = 0; i < 3000; ++i)
+	{
+		const uint64_t bits = rng() >> (rng() % 64);
+		test_template_base_types<10>(bits);
+		test_template_base_types<16>(bits);
+		test_template_base_types<8>(bits);
+		test_template_base_types<2>(bits);
+		test_template_base_types<32>(bits);
+		test_template_base_types<3>(bits);
+		test_template_base_types<36>(bits);
+	}
+	for (int i = 0; i < 3000; ++i)
+	{
+		const uint64_t bits = rng();
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		test_template_format<std::chars_format::general>(d);
+		test_template_format<std::chars_format::scientific>(d);
+		test_template_format<std::chars_format::fixed>(d);
+		test_template_format<std::chars_format::hex>(d);
+		test_template_format<std::chars_format::scientific>((float)d);
+	}
+	for (double d : { 0.0, -1.5, 1e21, 0.1, 5e-324 })
+	{
+		test_template_format<std::chars_format::general>(d);
+		test_template_format<std::chars_format::fixed>((float)d);
+	}
+	double d = 0;
+	assert(conv::str_to_float<std::chars_format::fixed>("2.5e3", d) && d == 2.5);
+	assert(!conv::str_to_float<std::chars_format::scientific>("2.5", d));
+	std::string s;
+	assert(conv::num_to_str<16>(0xBEEF, s) && s == "BEEF");
+	assert(conv::float_to_str<std::chars_format::scientific>(1500.0, s) && s == "1.5e+03");
+}
+
+// parse() reads the number at the start and points after it
+template<typename NumType, typename CharType>
+void test_parse(const std::basic_string<CharType>& text, NumType expected, size_t length, int base = 10)
+{
+	const std::basic_string<CharType> line = text + (CharType)',' + (CharType)'x';
+	const auto ret = [&line, base] {
+		if constexpr (std::is_floating_point_v<NumType>)
+			return conv::parse<NumType>(line);
+		else
+			return conv::parse<NumType>(line, base);
+	}();
+	static_assert(std::is_same_v<decltype(ret.end), const CharType*>);
+	assert(ret && ret.value == expected && ret.end == line.data() + length);
+}
+
+template<typename CharType>
+void test_parse_chars()
+{
+	const auto text = [](const char* s) { return std::basic_string<CharType>(s, s + strlen(s)); };
+	test_parse<int>(text("-123"), -123, 4);
+	test_parse<unsigned char>(text("255"), (unsigned char)255, 3);
+	test_parse<int64_t>(text("0x7fffffffffffffff"), INT64_MAX, 18, 16);
+	test_parse<uint32_t>(text("0007"), 7u, 4);
+	test_parse<int>(text("-00012"), -12, 6);
+	test_parse<uint16_t>(text("1010"), (uint16_t)10, 4, 2);
+	test_parse<double>(text("-2.5e3"), -2500.0, 6);
+	test_parse<float>(text("0.1"), 0.1f, 3);
+	test_parse<double>(text("1e-3"), 0.001, 4);
+
+	// a failure points at the start, or past the digits out of range
+	const std::basic_string<CharType> bad = text("x1");
+	auto ret = conv::parse<int>(bad);
+	assert(!ret && ret.error() == std::errc::invalid_argument && ret.end == bad.data() && ret.value == 0);
+	const std::basic_string<CharType> big = text("99999999999,1");
+	ret = conv::parse<int>(big);
+	assert(ret.ec == std::errc::result_out_of_range && ret.end == big.data() + 11 && ret.value == 0);
+	const std::basic_string<CharType> huge = text("1") + std::basic_string<CharType>(100, (CharType)'0') + (CharType)';';
+	ret = conv::parse<int>(huge);
+	assert(ret.ec == std::errc::result_out_of_range && ret.end == huge.data() + 101);
+	const std::basic_string<CharType> unsigned_neg = text("-1");
+	assert(!conv::parse<unsigned>(unsigned_neg) && conv::parse<unsigned>(unsigned_neg).end == unsigned_neg.data());
+	const auto overflow = conv::parse<double>(text("1e999 "));
+	assert(overflow.ec == std::errc::result_out_of_range && overflow.value == 0);
+	// a float longer than the narrowing buffer
+	const std::basic_string<CharType> long_float = text("1.") + std::basic_string<CharType>(300, (CharType)'5') + (CharType)'|';
+	const auto f = conv::parse<double>(long_float);
+	assert(f && f.value == 1.5555555555555556 && f.end == long_float.data() + 302);
+
+	// chained over a line with no second pass
+	const std::basic_string<CharType> csv = text("12, -7,0x1F;3.5");
+	const CharType* p = csv.data();
+	const CharType* const last = p + csv.size();
+	const auto a = conv::parse<int>(std::basic_string_view<CharType>(p, last - p));
+	p = a.end + 2;
+	const auto b = conv::parse<int>(std::basic_string_view<CharType>(p, last - p));
+	p = b.end + 1;
+	const auto c = conv::parse<int>(std::basic_string_view<CharType>(p, last - p), 16);
+	p = c.end + 1;
+	const auto d = conv::parse<double>(std::basic_string_view<CharType>(p, last - p), std::chars_format::fixed);
+	assert(a.value == 12 && b.value == -7 && c.value == 31 && d.value == 3.5 && d.end == last);
+}
+
+void test_parse_list()
+{
+	test_parse_chars<char>();
+	test_parse_chars<wchar_t>();
+	test_parse_chars<char16_t>();
+	test_parse_chars<char32_t>();
+
+	const char* text = "42 rest";
+	const auto ret = conv::parse<short>(text);
+	assert(ret.value == 42 && ret.end == text + 2);
+	assert(conv::parse<int>("").ec == std::errc::invalid_argument);
+	std::mt19937_64 rng(22);
+	for (int i = 0; i < 3000; ++i)
+	{
+		const int64_t n = (int64_t)(rng() >> (rng() % 64));
+		const std::string s = std::to_string(n);
+		test_parse<int64_t>(s, n, s.size());
+		const std::wstring ws(s.begin(), s.end());
+		test_parse<int64_t>(ws, n, s.size());
+		double d;
+		const uint64_t bits = rng();
+		memcpy(&d, &bits, sizeof(d));
+		if (d - d != 0)
+			continue;
+		std::string fs;
+		assert(conv::float_to_str(d, fs));
+		test_parse<double>(fs, d, fs.size());
+	}
+#ifdef __cpp_lib_expected
+	const std::expected<int, std::errc> good = conv::parse<int>("7");
+	const std::expected<int, std::errc> fail = conv::parse<int>("z");
+	assert(good && *good == 7 && !fail && fail.error() == std::errc::invalid_argument);
+#endif
+}
+
+// the grammar conv::classify() documents
+conv::num_kind classify_reference(const std::string& s)
+{
+	if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+		return s.find_first_not_of("0123456789abcdefABCDEF", 2) == std::string::npos ? conv::num_kind::hex : conv::num_kind::invalid;
+	size_t i = (!s.empty() && s[0] == '-') ? 1 : 0;
+	std::string word = s.substr(i);
+	for (char& c : word)
+		c = (char)tolower((unsigned char)c);
+	if (word == "inf" || word == "infinity" || word == "nan"
+		|| (word.compare(0, 4, "nan(") == 0 && word.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyz_", 4) == word.size() - 1 && word.back() == ')'))
+		return conv::num_kind::floating;
+	auto skip_digits = [&s, &i]() {
+		const size_t from = i;
+		while (i < s.size() && s[i] >= '0' && s[i] <= '9')
+			++i;
+		return i - from;
+	};
+	size_t mantissa = skip_digits();
+	const bool dot = i < s.size() && s[i] == '.';
+	if (dot)
+		++i;
+	mantissa += skip_digits();
+	if (mantissa == 0)
+		return conv::num_kind::invalid;
+	const bool exp = i < s.size() && (s[i] == 'e' || s[i] == 'E');
+	if (exp)
+	{
+		++i;
+		if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+			++i;
+		if (skip_digits() == 0)
+			return conv::num_kind::invalid;
+	}
+	if (i != s.size())
+		return conv::num_kind::invalid;
+	return dot || exp ? conv::num_kind::floating : conv::num_kind::integer;
+}
+
+void test_classify(const std::string& s)
+{
+	// an exact size heap copy, so that reading past the end is caught
+	std::unique_ptr<char[]> copy(new char[s.size() + 1]);
+	memcpy(copy.get(), s.data(), s.size());
+	const conv::classify_result ret = conv::classify(std::string_view(copy.get(), s.size()));
+	assert(ret.kind == classify_reference(s));
+	if (ret.kind == conv::num_kind::invalid)
+		return;
+	assert(ret.negative == (s[0] == '-'));
+	double d;
+	std::errc ec = std::errc();
+	if (ret.kind != conv::num_kind::hex)
+		assert(conv::str_to_float(s, d, std::chars_format::general, &ec) || ec == std::errc::result_out_of_range);
+	if (ret.kind == conv::num_kind::integer && ret.digits <= 18)
+	{
+		long long n = 0;
+		assert(conv::str_to_num(s, n));
+		assert(std::to_string(n < 0 ? -n : n).size() == ret.digits);
+	}
+	if (ret.kind == conv::num_kind::hex && ret.digits <= 16)
+	{
+		unsigned long long n = 0;
+		assert(conv::str_to_num(s, n, 16));
+		size_t digits = 1;
+		while (n >>= 4)
+			++digits;
+		assert(ret.digits == digits);
+	}
+}
+
+void test_classify_list()
+{
+	using kind = conv::num_kind;
+	assert(conv::classify("123").kind == kind::integer && conv::classify("123").digits == 3);
+	assert(conv::classify("-0007").digits == 1 && conv::classify("-0007").negative);
+	assert(conv::classify("000").digits == 1);
+	assert(conv::classify("2147483648").digits == 10);
+	assert(conv::classify("0x00FF").kind == kind::hex && conv::classify("0x00FF").digits == 2);
+	assert(conv::classify("0.00120").kind == kind::floating && conv::classify("0.00120").digits == 3);
+	assert(conv::classify("1e5").kind == kind::floating && conv::classify("-.5").kind == kind::floating);
+	assert(conv::classify("-Infinity").kind == kind::floating && conv::classify("nan(0x1)").kind == kind::floating);
+	const char* invalid[] = { "", "-", "+1", "1e", "1e+", "1.2.3", "0x", "-0x1", "0x1g", "1 ", " 1", "e5", ".", "infinit", "nan(", "1-2" };
+	for (const char* s : invalid)
+		assert(conv::classify(s).kind == kind::invalid);
+
+	std::mt19937_64 rng(23);
+	const std::string alphabet = "0123456789.-+eExXaAfFin";
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::string s;
+		const size_t len = rng() % 80;
+		if (i % 2)
+		{
+			for (size_t k = 0; k < len; ++k)
+				s += alphabet[rng() % alphabet.size()];
+		}
+		else
+		{
+			// mostly well formed numbers around the 8, 16, 32 and 64 byte edges
+			if (rng() % 2)
+				s += '-';
+			if (rng() % 4 == 0)
+				s += "0x";
+			s.append(rng() % 4, '0');
+			while (s.size() < len)
+				s += (char)('0' + rng() % 10);
+			if (rng() % 3 == 0)
+				s.insert(s.begin() + (ptrdiff_t)(rng() % (s.size() + 1)), '.');
+			if (rng() % 3 == 0)
+				s += (rng() % 2 ? "e-" : "E") + std::to_string(rng() % 400);
+		}
+		test_classify(s);
+	}
+
+	const std::string_view strs[] = { "12", "0x1f", "1.5", "bad" };
+	conv::classify_result results[4];
+	assert(conv::classify_batch(strs, results, 4) == 1);
+	assert(results[0].kind == kind::integer && results[1].kind == kind::hex && results[2].kind == kind::floating && results[3].kind == kind::invalid);
+}
+
+// decimal text with group between every 3 digits, the slow way
+std::string group_reference(const std::string& text, char group)
+{
+	const size_t digits = text[0] == '-' ? 1 : 0;
+	size_t int_last = text.find_first_not_of("0123456789", digits);
+	if (int_last == std::string::npos)
+		int_last = text.size();
+	std::string out = text;
+	for (size_t pos = int_last; pos > digits + 3; pos -= 3)
+		out.insert(pos - 3, 1, group);
+	return out;
+}
+
+template<typename CharType>
+void test_punctuation_chars()
+{
+	const conv::punctuation euro = { '.', ',' };
+	const std::basic_string<CharType> text = { '-', '1', '.', '2', '3', '4', ',', '5' };
+	double d = 0;
+	assert(conv::str_to_float(text, d, euro) && d == -1234.5);
+	int n = 0;
+	assert(conv::str_to_num(text, n, euro) && n == -1234);
+	std::basic_string<CharType> str;
+	assert(conv::float_to_str(-1234.5, str, euro) && str == text);
+	CharType buf[16];
+	assert(conv::num_to_str(-1234, buf, 16, euro) && str.compare(0, 6, buf) == 0 && buf[6] == CharType());
+}
+
+void test_punctuation_list()
+{
+	test_punctuation_chars<char>();
+	test_punctuation_chars<wchar_t>();
+	test_punctuation_chars<char16_t>();
+	test_punctuation_chars<char32_t>();
+
+	const conv::punctuation us;
+	const conv::punctuation euro = { '.', ',' };
+	const conv::punctuation swiss = { '\'', '.' };
+	int n = 0;
+	assert(conv::str_to_num("1,234,567", n, us) && n == 1234567);
+	assert(conv::str_to_num("1.234.567", n, euro) && n == 1234567);
+	assert(conv::str_to_num("-12'345", n, swiss) && n == -12345);
+	assert(conv::str_to_num("1234567", n, us) && n == 1234567);
+	// a separator out of place ends the number
+	auto prefix = [](const char* text, const conv::punctuation& punct) {
+		const char* const last = text + strlen(text);
+		long long value = 0;
+		std::errc ec = std::errc();
+		const bool ok = conv::str_to_num(std::string_view(text, (size_t)(last - text)), value, punct, &ec);
+		return ok ? value : -1;
+	};
+	assert(prefix("1,23", us) == 1 && prefix("1,2345", us) == 1 && prefix("1234,567", us) == 1234);
+	assert(prefix("12,345,", us) == 12345 && prefix("0,001", us) == 1 && prefix(",123", us) == -1);
+	assert(prefix("1,234", conv::punctuation{ '\0', '.' }) == 1);
+	short s = 0;
+	std::errc ec = std::errc();
+	assert(!conv::str_to_num("32,768", s, us, &ec) && ec == std::errc::result_out_of_range);
+	assert(conv::str_to_num("-32,768", s, us) && s == -32768);
+	unsigned long long u = 0;
+	assert(conv::str_to_num("18,446,744,073,709,551,615", u, us) && u == UINT64_MAX);
+	assert(!conv::str_to_num("18,446,744,073,709,551,616", u, us, &ec) && ec == std::errc::result_out_of_range);
+
+	double d = 0;
+	assert(conv::str_to_float("1.234.567,89", d, euro) && d == 1234567.89);
+	assert(conv::str_to_float("1,234,567.89", d, us) && d == 1234567.89);
+	assert(conv::str_to_float("0,5e3", d, euro) && d == 500);
+	assert(conv::str_to_float("1,5", d, us) && d == 1);
+	// more than 19 digits and a halfway case take the slower paths
+	double plain = 0;
+	assert(conv::str_to_float("123,456,789,012,345,678,901.5", d, us) && conv::str_to_float("123456789012345678901.5", plain) && d == plain);
+	assert(conv::str_to_float("9,007,199,254,740,993", d, us) && conv::str_to_float("9007199254740993", plain) && d == plain);
+	assert(conv::str_to_float("9,007,199,254,740,993,000,001e-6", d, us) && conv::str_to_float("9007199254740993000001e-6", plain) && d == plain);
+	std::string long_text = "1";
+	for (int i = 0; i < 300; ++i)
+		long_text += ",000";
+	assert(conv::str_to_float(long_text + "e-900", d, us) && d == 1);
+	assert(conv::str_to_float(long_text + ",5e-900", d, euro) && d == 1);
+
+	std::string str;
+	assert(conv::num_to_str(1234567, str, us) && str == "1,234,567");
+	assert(conv::num_to_str(-123, str, euro) && str == "-123");
+	assert(conv::num_to_str(INT64_MIN, str, swiss) && str == "-9'223'372'036'854'775'808");
+	char buf[8];
+	assert(conv::num_to_str(123456, buf, 8, us) && strcmp(buf, "123,456") == 0);
+	assert(!conv::num_to_str(1234567, buf, 8, us) && buf[0] == '\0');
+	assert(conv::float_to_str(1234567.89, str, euro, std::chars_format::fixed) && str == "1.234.567,89");
+	assert(conv::float_to_str(1e20, str, us) && str == "1e+20");
+	assert(conv::float_to_str(1e20, str, us, std::chars_format::fixed) && str == "100,000,000,000,000,000,000");
+	assert(conv::float_to_str(0.25, str, euro) && str == "0,25");
+	// hex keeps its '.', which str_to_float() reads back with punct
+	assert(conv::float_to_str(-1.5, str, euro, std::chars_format::hex) && str == "-1.8p+0");
+	double hex_back = 0;
+	assert(conv::str_to_float(str, hex_back, euro, std::chars_format::hex) && hex_back == -1.5);
+	wchar_t hex_wide[32];
+	assert(conv::float_to_str(1e300, hex_wide, 32, euro, std::chars_format::hex) && conv::str_to_float(hex_wide, hex_back, euro, std::chars_format::hex) && hex_back == 1e300);
+	assert(conv::float_to_str(-1e300, str, us, std::chars_format::fixed) && str.size() == 1 + 301 + 100);
+	// the longest grouped text fits wide arrays as it fits the string
+	std::string longest;
+	assert(conv::float_to_str(-1e308, longest, us, std::chars_format::fixed) && longest.size() == 1 + 309 + 102);
+	wchar_t wide[1000];
+	assert(conv::float_to_str(-1e308, wide, 1000, us, std::chars_format::fixed) && std::wstring(wide) == std::wstring(longest.begin(), longest.end()));
+	char16_t wide16[1000];
+	assert(conv::float_to_str(1e308, wide16, 1000, euro, std::chars_format::fixed) && wide16[0] == u'1' && wide16[3] == u'.');
+	assert(std::u16string(wide16).size() == 309 + 102);
+	assert(!conv::float_to_str(-1e308, wide, longest.size(), us, std::chars_format::fixed) && wide[0] == L'\0');
+
+	std::mt19937_64 rng(24);
+	for (int i = 0; i < 3000; ++i)
+	{
+		const int64_t v = (int64_t)(rng() >> (rng() % 64));
+		assert(conv::num_to_str(v, str, us) && str == group_reference(std::to_string(v), ','));
+		long long back = 0;
+		assert(conv::str_to_num(str, back, us) && back == v);
+		double f;
+		const uint64_t bits = rng();
+		memcpy(&f, &bits, sizeof(f));
+		if (f - f != 0)
+			continue;
+		std::string plain_text;
+		assert(conv::float_to_str(f, plain_text, std::chars_format::fixed));
+		assert(conv::float_to_str(f, str, euro, std::chars_format::fixed));
+		std::string expected = group_reference(plain_text, '.');
+		const size_t point = plain_text.find('.');
+		if (point != std::string::npos)
+			expected[expected.size() - (plain_text.size() - point)] = ',';
+		assert(str == expected);
+		double f_back = 0;
+		assert(conv::str_to_float(str, f_back, euro) && f_back == f);
+	}
+}
+
+// scaled / 10^scale as text, the slow way
+std::string decimal_reference(int64_t scaled, int scale)
+{
+	const uint64_t magnitude = scaled < 0 ? 0 - (uint64_t)scaled : (uint64_t)scaled;
+	std::string digits = std::to_string(magnitude);
+	if (digits.size() <= (size_t)scale)
+		digits.insert(0, scale + 1 - digits.size(), '0');
+	if (scale > 0)
+		digits.insert(digits.size() - scale, 1, '.');
+	return scaled < 0 ? "-" + digits : digits;
+}
+
+// str_to_decimal() of text and the error, checked against its prefix
+int64_t decimal_of(const char* text, int scale, conv::rounding mode, std::errc expected = std::errc(), size_t length = std::string::npos)
+{
+	int64_t scaled = 12345;
+	std::errc ec = std::errc::io_error;
+	const bool ok = conv::str_to_decimal(text, scaled, scale, mode, &ec);
+	assert(ok == (ec == std::errc()) && ec == expected);
+	if (ec != std::errc())
+	{
+		assert(scaled == 12345);
+		return 0;
+	}
+	if (length != std::string::npos)
+	{
+		// the same value from the text up to where parsing stopped
+		int64_t prefix = 0;
+		assert(conv::str_to_decimal(std::string(text, length), prefix, scale, mode) && prefix == scaled);
+	}
+	return scaled;
+}
+
+template<typename CharType>
+void test_decimal_chars()
+{
+	const std::basic_string<CharType> text = { '-', '1', '2', '3', '.', '4', '5', '0', '0' };
+	int64_t scaled = 0;
+	assert(conv::str_to_decimal(text, scaled, 4) && scaled == -1234500);
+	assert(conv::str_to_decimal(text.c_str(), scaled, 1) && scaled == -1234);
+	assert(conv::str_to_decimal(text.c_str(), scaled, 1, conv::rounding::half_up) && scaled == -1235);
+	std::basic_string<CharType> str;
+	assert(conv::decimal_to_str(-1234500, 4, str) && str == text);
+	CharType buf[16];
+	assert(conv::decimal_to_str(-1234500, 4, buf, 16) && str == buf);
+	assert(!conv::decimal_to_str(-1234500, 4, buf, 9) && buf[0] == CharType());
+}
+
+void test_decimal_list()
+{
+	test_decimal_chars<char>();
+	test_decimal_chars<wchar_t>();
+	test_decimal_chars<char16_t>();
+	test_decimal_chars<char32_t>();
+
+	using rounding = conv::rounding;
+	assert(decimal_of("123.4500", 4, rounding::truncate) == 1234500);
+	assert(decimal_of("123.45", 4, rounding::truncate) == 1234500);
+	assert(decimal_of("123", 2, rounding::truncate) == 12300);
+	assert(decimal_of("-0.07", 2, rounding::truncate) == -7);
+	assert(decimal_of(".5", 1, rounding::truncate) == 5);
+	assert(decimal_of("-.5", 1, rounding::truncate) == -5);
+	assert(decimal_of("5.", 1, rounding::truncate, std::errc(), 2) == 50);
+	assert(decimal_of("007.10", 0, rounding::truncate) == 7);
+	assert(decimal_of("0.00000000000000000000000001", 18, rounding::half_up) == 0);
+	// parsing stops at anything that is not a digit or the point
+	assert(decimal_of("12.5x", 2, rounding::truncate, std::errc(), 4) == 1250);
+	assert(decimal_of("1e5", 2, rounding::truncate, std::errc(), 1) == 100);
+	assert(decimal_of("1.2.3", 2, rounding::truncate, std::errc(), 3) == 120);
+	assert(decimal_of("1,5", 2, rounding::truncate, std::errc(), 1) == 100);
+	assert(decimal_of("3.x", 2, rounding::truncate, std::errc(), 2) == 300);
+	for (const char* bad : { "", "-", ".", "-.", "x1", "+1", " 1", ".e1", "--1" })
+		decimal_of(bad, 2, rounding::half_even, std::errc::invalid_argument);
+	decimal_of("1", -1, rounding::truncate, std::errc::invalid_argument);
+	decimal_of("1", 19, rounding::truncate, std::errc::invalid_argument);
+
+	// rounding of the digits past the scale
+	assert(decimal_of("0.125", 2, rounding::truncate) == 12);
+	assert(decimal_of("0.125", 2, rounding::half_up) == 13);
+	assert(decimal_of("0.125", 2, rounding::half_even) == 12);
+	assert(decimal_of("0.135", 2, rounding::half_even) == 14);
+	assert(decimal_of("0.1250000000000000000000001", 2, rounding::half_even) == 13);
+	assert(decimal_of("0.1249999999999999999999999", 2, rounding::half_up) == 12);
+	assert(decimal_of("-0.125", 2, rounding::half_up) == -13);
+	assert(decimal_of("-0.125", 2, rounding::half_even) == -12);
+	assert(decimal_of("-0.004", 2, rounding::half_up) == 0);
+	assert(decimal_of("0.995", 2, rounding::half_up) == 100);
+	assert(decimal_of("99.5", 0, rounding::half_even) == 100);
+	assert(decimal_of("2.5", 0, rounding::half_even) == 2);
+
+	// the int64_t limits
+	assert(decimal_of("92233720368547.75807", 5, rounding::truncate) == INT64_MAX);
+	assert(decimal_of("-92233720368547.75808", 5, rounding::truncate) == INT64_MIN);
+	assert(decimal_of("9223372036854775807", 0, rounding::truncate) == INT64_MAX);
+	assert(decimal_of("0.922337203685477580", 18, rounding::truncate) == 922337203685477580);
+	assert(decimal_of("9.223372036854775807", 18, rounding::truncate) == INT64_MAX);
+	assert(decimal_of("92233720368547.758074", 5, rounding::half_up) == INT64_MAX);
+	decimal_of("92233720368547.758075", 5, rounding::half_up, std::errc::result_out_of_range);
+	assert(decimal_of("-92233720368547.758085", 5, rounding::half_even) == INT64_MIN);
+	decimal_of("-92233720368547.758085", 5, rounding::half_up, std::errc::result_out_of_range);
+	decimal_of("92233720368547.75808", 5, rounding::truncate, std::errc::result_out_of_range);
+	decimal_of("92233720368548", 5, rounding::truncate, std::errc::result_out_of_range);
+	decimal_of("10", 18, rounding::truncate, std::errc::result_out_of_range);
+	decimal_of("100000000000000000000000", 0, rounding::truncate, std::errc::result_out_of_range);
+
+	std::string str;
+	assert(conv::decimal_to_str(1234500, 4, str) && str == "123.4500");
+	assert(conv::decimal_to_str(5, 3, str) && str == "0.005");
+	assert(conv::decimal_to_str(-5, 1, str) && str == "-0.5");
+	assert(conv::decimal_to_str(0, 2, str) && str == "0.00");
+	assert(conv::decimal_to_str(42, 0, str) && str == "42");
+	assert(conv::decimal_to_str(INT64_MIN, 18, str) && str == "-9.223372036854775808");
+	assert(conv::decimal_to_str(INT64_MAX, 0, str) && str == "9223372036854775807");
+	assert(!conv::decimal_to_str(1, 19, str) && str == "9223372036854775807");
+	assert(!conv::decimal_to_str(1, -1, str));
+	char buf[8];
+	assert(conv::decimal_to_str(-12345, 2, buf, 8) && strcmp(buf, "-123.45") == 0);
+	assert(!conv::decimal_to_str(-123456, 2, buf, 8) && buf[0] == '\0');
+
+	std::mt19937_64 rng(25);
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int scale = (int)(rng() % 19);
+		const int64_t v = (int64_t)(rng() >> (rng() % 64));
+		assert(conv::decimal_to_str(v, scale, str) && str == decimal_reference(v, scale));
+		int64_t back = 0;
+		assert(conv::str_to_decimal(str, back, scale, rounding::truncate) && back == v);
+
+		// extra digits past the scale, rounded against the reference
+		if (v == INT64_MIN || v == INT64_MAX)
+			continue;
+		std::string tail(rng() % 6, '0');
+		for (char& c : tail)
+			c = (char)('0' + rng() % 10);
+		if (rng() % 4 == 0 && !tail.empty())
+			tail = "5" + std::string(tail.size() - 1, '0');
+		const std::string text = str + (scale == 0 ? "." : "") + tail;
+		const bool above = !tail.empty() && (tail[0] > '5' || (tail[0] == '5' && tail.find_first_not_of('0', 1) != std::string::npos));
+		const bool half = !tail.empty() && tail[0] == '5' && !above;
+		const int64_t away = v < 0 ? -1 : 1;
+		const int64_t expected[] = {
+			v,
+			above || half ? v + away : v,
+			above || (half && (v & 1) != 0) ? v + away : v
+		};
+		for (int m = 0; m < 3; ++m)
+		{
+			int64_t scaled = 0;
+			assert(conv::str_to_decimal(text, scaled, scale, (rounding)m) && scaled == expected[m]);
+		}
+	}
+}
+
+// allocator counting what it hands out
+size_t counted_allocations = 0;
+
+template<typename T>
+struct counting_allocator
+{
+	using value_type = T;
+	counting_allocator() = default;
+	template<typename U>
+	counting_allocator(const counting_allocator<U>&) {}
+	T* allocate(size_t n)
+	{
+		++counted_allocations;
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+	template<typename U>
+	bool operator==(const counting_allocator<U>&) const { return true; }
+	template<typename U>
+	bool operator!=(const counting_allocator<U>&) const { return false; }
+};
+
+using counted_string = std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
+using counted_wstring = std::basic_string<wchar_t, std::char_traits<wchar_t>, counting_allocator<wchar_t>>;
+
+void test_allocator_list()
+{
+	counted_string s;
+	counted_allocations = 0;
+	assert(conv::num_to_str(-1234567890123456789LL, s) && s == "-1234567890123456789");
+	assert(conv::float_to_str(0.1, s, 2000) && s.size() == 2002 && counted_allocations > 0);
+	char big[2100];
+	const auto ret = std::to_chars(big, big + sizeof(big), 0.1, std::chars_format::fixed, 2000);
+	assert(ret.ec == std::errc() && s == std::string_view(big, ret.ptr - big));
+	assert(conv::float_to_str(1e300, s, 1100) && s.size() == 301 + 1 + 1100 && s.back() == '0');
+
+	counted_wstring ws;
+	assert(conv::num_to_str(255, ws, 16) && ws == L"FF");
+	assert(conv::float_to_str(2.5, ws) && ws == L"2.5");
+	// widening into a wide string with the capacity allocates nothing
+	ws.reserve(64);
+	counted_allocations = 0;
+	assert(conv::num_to_str(INT64_MIN, ws) && conv::float_to_str(-2.2250738585072014e-308, ws) && counted_allocations == 0);
+
+	// to_str() with an allocator draws from it
+	counted_allocations = 0;
+	const counted_string big_int = conv::to_str(std::string(40, 'x'), counting_allocator<char>());
+	assert(big_int == std::string(40, 'x').c_str() && counted_allocations > 0);
+	assert(conv::to_str(0.5, counting_allocator<char>()) == "0.5");
+	assert(conv::to_str(true, counting_allocator<int>()) == "true");
+	const counted_wstring wide = conv::to_str(-42, counting_allocator<wchar_t>());
+	assert(wide == L"-42");
+
+	// the writer grows a string of any allocator
+	counted_string line;
+	conv::writer w(line);
+	assert(w.write(1) && w.write(',') && w.write(2.25) && w.view() == "1,2.25");
+
+	// the parallel formatter takes its chunk scratch from the allocator too
+	std::vector<double> doubles(140000);
+	for (size_t i = 0; i < doubles.size(); ++i)
+		doubles[i] = (double)i / 8;
+	counted_string joined;
+	std::string expected;
+	assert(conv::float_to_str_batch(doubles.data(), doubles.size(), ',', expected));
+	counted_allocations = 0;
+	assert(conv::float_to_str_parallel(doubles.data(), doubles.size(), ',', joined, std::chars_format::general, 2));
+	assert(joined == expected.c_str() && counted_allocations > 3);
+
+	// std::pmr strings from a monotonic arena
+	char arena[4096];
+	std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+	std::pmr::string ps(&resource);
+	assert(conv::num_to_str(UINT64_MAX, ps) && ps == "18446744073709551615");
+	assert(conv::append(ps, ',') && conv::append(ps, 1.5) && ps == "18446744073709551615,1.5");
+	const std::pmr::string pt = conv::to_str(3.25f, &resource);
+	assert(pt == "3.25" && pt.get_allocator().resource() == &resource);
+	const std::pmr::wstring pw = conv::to_wstr(std::string("conv"), &resource);
+	assert(pw == L"conv" && pw.get_allocator().resource() == &resource);
+}
+
+void test_stats_list()
+{
+	const conv::stats_snapshot before = conv::stats();
+	int n = 0;
+	std::errc ec = std::errc();
+	assert(conv::str_to_num("1234", n) && n == 1234);
+	assert(!conv::str_to_num("x", n, 10, &ec) && ec == std::errc::invalid_argument);
+	assert(!conv::str_to_num("99999999999", n));
+	assert(conv::str_to_num(L"-7", n) && n == -7);
+	double d = 0;
+	assert(conv::str_to_float(std::wstring(200, L'1'), d) && d == 1.1111111111111111e199);
+	assert(!conv::str_to_float<std::chars_format::fixed>("abc", d));
+	std::string s;
+	assert(conv::num_to_str(255, s, 16) && s == "FF");
+	assert(!conv::num_to_str(255, s, 3));
+	char small[4];
+	assert(!conv::num_to_str(123456, small, sizeof(small)) && conv::num_to_str<16>(255, small, sizeof(small)));
+	assert(conv::float_to_str(0.1, s, 100) && s.size() == 102);
+	wchar_t wide[8];
+	assert(conv::float_to_str(0.5, wide, 8) && wide == std::wstring(L"0.5"));
+	conv::stats_snapshot diff = conv::stats() - before;
+
+	const auto& parse = diff[conv::stat_family::str_to_num];
+	assert(parse.calls == 4 && parse.failures() == 2);
+	assert(parse.failures(std::errc::invalid_argument) == 1 && parse.failures(std::errc::result_out_of_range) == 1);
+	assert(parse.bytes == 4 + 1 + 11 + 2 * sizeof(wchar_t));
+	const auto& parse_float = diff[conv::stat_family::str_to_float];
+	assert(parse_float.calls == 2 && parse_float.failures() == 1 && parse_float.bytes == 200 * sizeof(wchar_t) + 3);
+	const auto& format = diff[conv::stat_family::num_to_str];
+	assert(format.calls == 4 && format.bytes == 2 + 2);
+	assert(format.failures(std::errc::invalid_argument) == 1 && format.failures(std::errc::value_too_large) == 1);
+	const auto& format_float = diff[conv::stat_family::float_to_str];
+	assert(format_float.calls == 2 && format_float.failures() == 0 && format_float.bytes == 102 + 3 * sizeof(wchar_t));
+	// the 102 characters, the long wide float is read in place
+	assert(diff.allocations == 1);
+
+	// one call in CONV_STATS_SAMPLE_RATE is timed
+	const conv::stats_snapshot timed = conv::stats();
+	for (int i = 0; i < 64 * 10; ++i)
+		assert(conv::str_to_num("42", n));
+	diff = conv::stats() - timed;
+	uint64_t sampled = 0;
+	for (uint64_t count : diff[conv::stat_family::str_to_num].latency)
+		sampled += count;
+	assert(sampled == 10 && diff[conv::stat_family::str_to_num].calls == 640);
+
+	// the calls of other threads add up, and a thread started after one
+	// ended takes over its counters
+	const conv::stats_snapshot threaded = conv::stats();
+	for (int i = 0; i < 3; ++i)
+	{
+		std::thread worker([] {
+			for (int j = 0; j < 100; ++j)
+			{
+				std::string text;
+				assert(conv::num_to_str(j, text));
+			}
+		});
+		worker.join();
+	}
+	diff = conv::stats() - threaded;
+	assert(diff[conv::stat_family::num_to_str].calls == 300 && diff[conv::stat_family::num_to_str].bytes == 190 * 3);
+}
+
+template<typename NumType>
+void test_str_to_num_delimited()
+{
+	NumType nums[8] = {};
+	auto ret = conv::str_to_num_delimited("12,345\n7,,99\n", ",\n", nums, 8);
+	assert(ret.count == 4 && ret.offset == 13 && ret.ec == std::errc());
+	assert(nums[0] == 12 && nums[1] == 345 && nums[2] == 7 && nums[3] == 99);
+
+	// capacity reached: offset is where the next call resumes
+	ret = conv::str_to_num_delimited("1 2 3 4", " ", nums, 2);
+	assert(ret.count == 2 && ret.offset == 4 && ret.ec == std::errc());
+	ret = conv::str_to_num_delimited(std::string_view("1 2 3 4").substr(ret.offset), " ", nums, 8);
+	assert(ret.count == 2 && nums[0] == 3 && nums[1] == 4);
+
+	// first error stops the sweep at the bad field
+	ret = conv::str_to_num_delimited("5;6x;7", ";", nums, 8);
+	assert(ret.count == 1 && ret.offset == 2 && ret.ec == std::errc::invalid_argument);
+	ret = conv::str_to_num_delimited("5;99999999999999999999;7", ";", nums, 8);
+	assert(ret.count == 1 && ret.offset == 2 && ret.ec == std::errc::result_out_of_range);
+
+	// long fields take the wide vector path
+	std::string long_fields = "0000000000000000000000000000000000042,00000000000000000000000000000000000043";
+	ret = conv::str_to_num_delimited(long_fields, ",", nums, 8);
+	assert(ret.count == 2 && nums[0] == 42 && nums[1] == 43);
+
+	ret = conv::str_to_num_delimited("0x1F|10", "|", nums, 8, 16);
+	assert(ret.count == 2 && nums[0] == 31 && nums[1] == 16);
+}
+
+void test_str_to_num_delimited_list()
+{
+	test_str_to_num_delimited<int16_t>();
+	test_str_to_num_delimited<uint16_t>();
+	test_str_to_num_delimited<int32_t>();
+	test_str_to_num_delimited<uint32_t>();
+	test_str_to_num_delimited<int64_t>();
+	test_str_to_num_delimited<uint64_t>();
+
+	double nums[4] = {};
+	auto ret = conv::str_to_float_delimited("1.5\t-2e3\t0.25", "\t", nums, 4);
+	assert(ret.count == 3 && nums[0] == 1.5 && nums[1] == -2000 && nums[2] == 0.25);
+	int32_t ints[4] = {};
+	ret = conv::str_to_num_delimited("-7,-8", ",", ints, 4);
+	assert(ret.count == 2 && ints[0] == -7 && ints[1] == -8);
+}
+
+// feeding a stream split at any point must match parsing it in one piece
+template<typename NumType>
+void test_incremental_parser(const std::string& stream, int base = 10)
+{
+	NumType expected[64];
+	auto ret = conv::str_to_num_delimited(stream, ",\n", expected, 64, base);
+
+	for (size_t split = 0; split <= stream.size(); ++split)
+	{
+		std::vector<NumType> values;
+		auto push = [&values](NumType n) { values.push_back(n); };
+		conv::incremental_parser<NumType> parser(",\n", base);
+		std::errc ec;
+		bool ok = parser.feed(std::string_view(stream).substr(0, split), push, &ec)
+			&& parser.feed(std::string_view(stream).substr(split), push, &ec);
+		ok = parser.finish(push, &ec) && ok;
+		assert(ok == (ret.ec == std::errc()));
+		assert(ec == ret.ec);
+		assert(values.size() == ret.count && parser.count() == ret.count);
+		for (size_t i = 0; i < values.size(); ++i)
+			assert(values[i] == expected[i]);
+	}
+
+	std::vector<NumType> values;
+	conv::incremental_parser<NumType> parser(",\n", base);
+	for (char c : stream)
+	{
+		if (!parser.feed(std::string_view(&c, 1), [&values](NumType n) { values.push_back(n); }))
+			break;
+	}
+	(void)parser.finish([&values](NumType n) { values.push_back(n); });
+	assert(values.size() == ret.count);
+}
+
+void test_incremental_parser_list()
+{
+	test_incremental_parser<int32_t>("123,456\n-78,,9,");
+	test_incremental_parser<int32_t>("12345678901234,1");
+	test_incremental_parser<int32_t>("1,2x,3");
+	test_incremental_parser<int32_t>("1,-,3");
+	test_incremental_parser<uint32_t>("1,-2,3");
+	test_incremental_parser<uint64_t>("18446744073709551615,18446744073709551616");
+	test_incremental_parser<int64_t>("-9223372036854775808,1234567890123456789012345");
+	test_incremental_parser<int16_t>("32767,-32768,0000000000000000000000000000000000000000012");
+	test_incremental_parser<uint16_t>("0x1F,ff,0x,3", 16);
+	test_incremental_parser<int64_t>("0X7fffffffffffffff,-1a", 16);
+	test_incremental_parser<uint32_t>("777,10", 8);
+
+	conv::incremental_parser<int32_t> parser;
+	int32_t sum = 0;
+	auto add = [&sum](int32_t n) { sum += n; };
+	assert(parser.feed("12", add) && parser.feed("3,4", add) && parser.finish(add));
+	assert(sum == 127 && parser.count() == 2);
+	assert(!parser.feed(",z", add) && !parser.feed("1", add));
+	parser.reset();
+	assert(parser.feed("5\n", add) && sum == 132);
+}
+
+void test_load_numbers_list()
+{
+#ifdef CONV_HAS_LOADER
+	const char* path = "conv_load_numbers_test.txt";
+	std::vector<int64_t> expected;
+	{
+		std::ofstream file(path);
+		for (int64_t i = 0; i < 100000; ++i)
+		{
+			int64_t n = (i * 7919 - 350000) * (i % 5 == 0 ? 1000003 : 1);
+			expected.push_back(n);
+			file << n << (i % 10 == 9 ? "\n" : ",");
+		}
+		file << "42"; // no trailing delimiter
+		expected.push_back(42);
+	}
+	std::vector<int64_t> nums;
+	auto ret = conv::load_numbers(path, nums);
+	assert(ret.ec == std::errc() && ret.count == expected.size() && nums == expected);
+	assert(ret.offset == ret.bytes && ret.bytes_per_second > 0);
+
+	std::vector<double> floats;
+	ret = conv::load_numbers(path, floats);
+	assert(ret.ec == std::errc() && floats.size() == expected.size() && floats[1] == (double)expected[1]);
+
+	std::vector<int16_t> small;
+	ret = conv::load_numbers(path, small);
+	assert(ret.ec == std::errc::result_out_of_range && small.size() == ret.count);
+
+	std::ofstream(path) << "";
+	ret = conv::load_numbers(path, nums);
+	assert(ret.ec == std::errc() && ret.count == 0 && nums.empty());
+	std::remove(path);
+
+	ret = conv::load_numbers(path, nums);
+	assert(ret.ec == std::errc::no_such_file_or_directory);
+#endif
+}
+
+// the parallel result must be identical to the serial one
+template<typename NumType>
+void test_str_to_num_parallel(const std::string& buf, unsigned threads)
+{
+	std::vector<NumType> expected(buf.size() / 2 + 1);
+	auto serial = conv::str_to_num_delimited(buf, ",\n", expected.data(), expected.size());
+	expected.resize(serial.count);
+
+	std::vector<NumType> nums;
+	auto ret = conv::str_to_num_parallel(buf, ",\n", nums, 10, threads);
+	assert(ret.count == serial.count && ret.offset == serial.offset && ret.ec == serial.ec);
+	assert(nums == expected);
+}
+
+void test_str_to_num_parallel_list()
+{
+	std::string buf;
+	uint64_t seed = 12345;
+	while (buf.size() < 3 * 1024 * 1024)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		buf += std::to_string((int64_t)(seed >> 20) - (int64_t)(1ull << 43));
+		buf += (seed & 0x300) ? "," : ",\n\n";
+	}
+	for (unsigned threads : { 1u, 2u, 3u, 8u, 0u })
+	{
+		test_str_to_num_parallel<int64_t>(buf, threads);
+		test_str_to_num_parallel<int32_t>(buf, threads); // out of range
+	}
+	for (size_t pos : { (size_t)0, buf.size() / 3, buf.size() - 3 })
+	{
+		std::string bad = buf;
+		bad[pos] = 'z';
+		test_str_to_num_parallel<int64_t>(bad, 4);
+	}
+
+	// short buffers fit the first block of the vector
+	for (const char* small : { "", "7", "1,2,3", "1,2,3,", "-12,,34\n5", "1,x" })
+	{
+		test_str_to_num_parallel<int64_t>(small, 1);
+		std::vector<int32_t> nums;
+		(void)conv::str_to_num_parallel(small, ",\n", nums, 10, 1);
+		assert(nums.capacity() <= strlen(small) / 2 + 1);
+	}
+
+	std::vector<double> floats;
+	auto ret = conv::str_to_float_parallel(buf, ",\n", floats, std::chars_format::general, 4);
+	assert(ret.ec == std::errc() && ret.offset == buf.size() && !floats.empty());
+}
+
+template<typename CharType>
+std::basic_string<CharType> widen(const std::string& str)
+{
+	return std::basic_string<CharType>(str.begin(), str.end());
+}
+
+// wide parsing must agree with parsing the same ASCII text narrow
+template<typename NumType, typename CharType>
+void test_str_to_num_wide(const std::string& src, int base)
+{
+	NumType expected = 7;
+	std::errc expected_ec = std::errc::io_error;
+	bool expected_ok = conv::str_to_num(src, expected, base, &expected_ec);
+
+	std::basic_string<CharType> wide = widen<CharType>(src);
+	NumType n = 7;
+	std::errc ec = std::errc::io_error;
+	assert(conv::str_to_num(std::basic_string_view<CharType>(wide), n, base, &ec) == expected_ok);
+	assert(n == expected && ec == expected_ec);
+}
+
+template<typename NumType, typename CharType>
+void test_str_to_float_wide(const std::string& src)
+{
+	NumType expected = 7;
+	std::errc expected_ec = std::errc::io_error;
+	bool expected_ok = conv::str_to_float(src, expected, std::chars_format::general, &expected_ec);
+
+	std::basic_string<CharType> wide = widen<CharType>(src);
+	NumType n = 7;
+	std::errc ec = std::errc::io_error;
+	assert(conv::str_to_float(std::basic_string_view<CharType>(wide), n, std::chars_format::general, &ec) == expected_ok);
+	assert((n == expected || (n != n && expected != expected)) && ec == expected_ec);
+}
+
+template<typename CharType>
+void test_str_to_num_wide_type()
+{
+	const std::string zeros(100, '0');
+	const std::string ones(100, '1');
+	const std::string samples[] = {
+		"", "-", "0", "-0", "12", "-12", "12abc", "0x1F", "0X", "0x-5", "00", "007",
+		"18446744073709551615", "18446744073709551616", "-9223372036854775808",
+		zeros, "-" + zeros + "42", "0x" + zeros + "ff", zeros + "65535", ones, "1" + zeros,
+		"42" + zeros + "x", "1111111111111111111111111111111111111111111111111111111111111111",
+	};
+	for (const std::string& src : samples)
+	{
+		for (int base : { 10, 16, 2 })
+		{
+			test_str_to_num_wide<int16_t, CharType>(src, base);
+			test_str_to_num_wide<uint16_t, CharType>(src, base);
+			test_str_to_num_wide<int32_t, CharType>(src, base);
+			test_str_to_num_wide<uint32_t, CharType>(src, base);
+			test_str_to_num_wide<int64_t, CharType>(src, base);
+			test_str_to_num_wide<uint64_t, CharType>(src, base);
+		}
+	}
+	const std::string floats[] = {
+		"", "1.5", "-2e3", "1e400", "nan", "inf", "0." + zeros + zeros + "1",
+		"1." + ones + ones, "3.25" + std::string(200, ' '), "x",
+	};
+	for (const std::string& src : floats)
+	{
+		test_str_to_float_wide<float, CharType>(src);
+		test_str_to_float_wide<double, CharType>(src);
+	}
+}
+
+void test_str_to_num_wide_list()
+{
+	test_str_to_num_wide_type<wchar_t>();
+	test_str_to_num_wide_type<char16_t>();
+	test_str_to_num_wide_type<char32_t>();
+
+	// non-ASCII code units are not truncated into digits
+	int32_t n = 7;
+	std::errc ec;
+	assert(!conv::str_to_num(L"\x0131", n, 10, &ec) && ec == std::errc::invalid_argument && n == 7);
+	assert(conv::str_to_num(u"12\x0133", n) && n == 12);
+	assert(!conv::str_to_num(U"\x1F5FF", n, 16));
+	double d = 0;
+	assert(!conv::str_to_float(L"\x0131.5", d));
+	assert(conv::str_to_float(u"2.5", d) && d == 2.5);
+	assert(conv::str_to_float(std::wstring(L"-0.5"), d) && d == -0.5);
+	assert(conv::str_to_float(u"1.5\x0135", d) && d == 1.5);
+	assert(conv::str_to_float(U"2\x0165\x0135", d) && d == 2);
+	assert(!conv::str_to_float(L"\x0149nf", d));
+	assert(conv::str_to_float(L"a\x0161", d, std::chars_format::hex) && d == 10);
+	// floats of any length are read in place, as the narrow text is
+	const std::string long_text = "0." + std::string(130, '0') + "1e+5|";
+	test_str_to_float_wide<double, wchar_t>(long_text);
+	test_str_to_float_wide<double, char16_t>("1" + std::string(400, '0') + "e-400");
+	test_str_to_float_wide<float, char32_t>("1." + std::string(200, '5'));
+	const std::u16string grouped = u"-1.234.567," + std::u16string(150, u'9');
+	assert(conv::str_to_float(grouped, d, conv::punctuation{ '.', ',' }) && d == -1234568);
+}
+
+// any integer type works, not only the fixed width ones
+template<typename NumType>
+void test_num_type()
+{
+	const NumType values[] = { (std::numeric_limits<NumType>::min)(), (std::numeric_limits<NumType>::max)(), 0, 1, (NumType)100 };
+	for (NumType value : values)
+	{
+		std::string s;
+		assert(conv::num_to_str(value, s));
+		assert(s == std::to_string(value));
+		wchar_t buf[40];
+		assert(conv::num_to_str(value, buf, 40));
+		assert(std::wstring(buf) == std::to_wstring(value));
+		assert(conv::to_str(value) == s);
+		assert(conv::to_str_fixed(value).view() == s);
+
+		NumType n = 7;
+		assert(conv::str_to_num(s, n) && n == value);
+		n = 7;
+		assert(conv::str_to_num(buf, n) && n == value);
+	}
+	NumType n = 7;
+	std::errc ec;
+	std::string too_big = std::to_string((std::numeric_limits<NumType>::max)()) + "0";
+	assert(!conv::str_to_num(too_big, n, 10, &ec) && ec == std::errc::result_out_of_range && n == 7);
+}
+
+void test_num_types_list()
+{
+	test_num_type<long>();
+	test_num_type<unsigned long>();
+	test_num_type<long long>();
+	test_num_type<unsigned long long>();
+	test_num_type<int8_t>();
+	test_num_type<uint8_t>();
+
+	int8_t i8 = 0;
+	assert(!conv::str_to_num("128", i8));
+	assert(conv::str_to_num("-128", i8) && i8 == -128);
+	assert(conv::str_to_num("7f", i8, 16) && i8 == 127);
+	assert(conv::to_str((unsigned char)200) == "200");
+	assert(conv::to_str('a') == "a");
+
+	std::u16string u16;
+	assert(conv::float_to_str(1.5, u16, 2) && u16 == u"1.50");
+	assert(conv::num_to_str(255, u16, 16) && u16 == u"FF");
+	std::u32string u32;
+	assert(conv::num_to_str(-42L, u32) && u32 == U"-42");
+	assert(conv::to_str(U"abc") == "abc");
+
+#ifdef __cpp_char8_t
+	long long ll = 0;
+	assert(conv::str_to_num(u8"-9223372036854775808", ll) && ll == (std::numeric_limits<long long>::min)());
+	assert(conv::str_to_num(std::u8string(u8"0x1F"), ll, 16) && ll == 31);
+	double d = 0;
+	assert(conv::str_to_float(std::u8string_view(u8"2.5"), d) && d == 2.5);
+	std::u8string u8;
+	assert(conv::num_to_str(1234, u8) && u8 == u8"1234");
+	assert(conv::float_to_str(0.5f, u8, std::chars_format::scientific) && u8 == u8"5e-01");
+	char8_t buf[8];
+	assert(conv::num_to_str(255, buf, 8, 16) && std::u8string_view(buf) == u8"ff");
+	assert(conv::to_str(u8"abc") == "abc");
+#endif
+}
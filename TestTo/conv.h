@@ -12,25 +12,183 @@
 #pragma once
 
 #include <charconv>
+#include <cfloat>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <string_view>
 #include <string>
-#include <sstream>
-#include <iomanip>
+#include <stdexcept>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
-#ifdef _WIN32
-#define SV_SPRINTF sprintf_s
+// Define CONV_DISABLE_SIMD to always use the scalar from_chars() path.
+// The AVX2 kernels need <immintrin.h>, which takes longer to compile than
+// the rest of conv.h, so they are built only with CONV_ENABLE_AVX2 or when
+// the compiler already targets AVX2.
+#if !defined(CONV_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define CONV_SIMD_X86
+#if defined(CONV_ENABLE_AVX2) || defined(__AVX2__)
+#define CONV_SIMD_AVX2
+#include <immintrin.h>
 #else
-#define SV_SPRINTF std::sprintf
-#include <cstring>
+#include <smmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+#ifdef _MSVC_LANG
+#define CONV_CPLUSPLUS _MSVC_LANG
+#else
+#define CONV_CPLUSPLUS __cplusplus
+#endif
+
+#if CONV_CPLUSPLUS >= 202002L && __has_include(<span>)
+#include <span>
+#define CONV_HAS_SPAN
+#endif
+
+#if CONV_CPLUSPLUS > 202002L && __has_include(<expected>)
+#include <expected>
+#endif
+
+// Define CONV_NO_ALLOC to leave out every function that can allocate:
+// those that write a std::basic_string or a std::vector, to_str() and the
+// loader. What remains never calls operator new and builds without
+// exceptions, for code that must not touch the heap.
+#ifdef CONV_NO_ALLOC
+#if defined(CONV_ENABLE_PARALLEL) || defined(CONV_ENABLE_PMR) || defined(CONV_ENABLE_STATS)
+#error "CONV_ENABLE_PARALLEL, CONV_ENABLE_PMR and CONV_ENABLE_STATS allocate and cannot be used with CONV_NO_ALLOC"
+#endif
+#include <cstdlib>
+#endif
+
+// conv::load_numbers() memory maps the file on Linux
+#if defined(__linux__) && !defined(CONV_NO_ALLOC)
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CONV_HAS_LOADER
+#endif
+
+// Define CONV_ENABLE_PMR for conv::to_str() into a std::pmr::string
+#ifdef CONV_ENABLE_PMR
+#include <memory_resource>
+#endif
+
+// Define CONV_ENABLE_PARALLEL for the multi-threaded conv::str_to_num_parallel()
+#ifdef CONV_ENABLE_PARALLEL
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
+
+// Define CONV_ENABLE_STATS for the conv::stats() counters of calls,
+// failures, bytes, allocations and sampled latency. Without it the
+// counting is not compiled at all.
+#ifdef CONV_ENABLE_STATS
+#include <atomic>
+#include <chrono>
+#include <new>
+// one call in CONV_STATS_SAMPLE_RATE per thread is timed
+#ifndef CONV_STATS_SAMPLE_RATE
+#define CONV_STATS_SAMPLE_RATE 64
+#endif
+#define CONV_STAT(...) __VA_ARGS__
+#else
+#define CONV_STAT(...)
+#endif
+
+#if defined(CONV_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CONV_TARGET(arch) __attribute__((target(arch)))
+#else
+#define CONV_TARGET(arch)
+#endif
+
+// true while a constexpr function is evaluated at compile time, where
+// conv takes plain loops instead of its SIMD and table paths
+#if defined(__cpp_lib_is_constant_evaluated)
+#define CONV_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(__clang__) && __clang_major__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define CONV_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define CONV_CONSTANT_EVALUATED() false
+#endif
+
+#if defined(__cpp_consteval)
+#define CONV_CONSTEVAL consteval
+#else
+#define CONV_CONSTEVAL constexpr
 #endif
 
 struct conv
 {
+    // group and decimal characters of a number's text, "1,234,567.89" by
+    // default and "1.234.567,89" with { '.', ',' }. A '\0' group neither
+    // reads nor writes separators. The two characters must differ.
+    struct punctuation
+    {
+        char group = ',';
+        char decimal = '.';
+    };
 private:
-    // convert std::wstring to std::string
+    // every conversion is a template on the character type and the number
+    // type, these are the types it accepts
+    //===================================
+    template<typename T>
+    static constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>
+        || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+#ifdef __cpp_char8_t
+        || std::is_same_v<T, char8_t>
+#endif
+        ;
+    // int8_t and unsigned char are numbers, char is a character
+    template<typename T>
+    static constexpr bool is_int_v = std::is_integral_v<T> && std::is_same_v<T, std::remove_cv_t<T>>
+        && !std::is_same_v<T, bool> && !is_char_v<T>;
+    template<typename T>
+    static constexpr bool is_float_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    template<typename T, typename R>
+    using enable_if_int_t = std::enable_if_t<is_int_v<T>, R>;
+    template<typename T, typename R>
+    using enable_if_float_t = std::enable_if_t<is_float_v<T>, R>;
+
+    // view of a std::basic_string, std::basic_string_view, C string or
+    // character array
+    //===================================
+    template<typename CharT, typename Traits, typename Alloc, typename = std::enable_if_t<is_char_v<CharT>>>
+    [[nodiscard]] static constexpr std::basic_string_view<CharT> view_of(const std::basic_string<CharT, Traits, Alloc>& str) {
+        return std::basic_string_view<CharT>(str.data(), str.size());
+    }
+    template<typename CharT, typename Traits, typename = std::enable_if_t<is_char_v<CharT>>>
+    [[nodiscard]] static constexpr std::basic_string_view<CharT> view_of(std::basic_string_view<CharT, Traits> str) {
+        return std::basic_string_view<CharT>(str.data(), str.size());
+    }
+    template<typename CharT, typename = std::enable_if_t<is_char_v<CharT>>>
+    [[nodiscard]] static constexpr std::basic_string_view<CharT> view_of(const CharT* str) {
+        return std::basic_string_view<CharT>(str);
+    }
+    template<typename Str>
+    using view_t = decltype(view_of(std::declval<const Str&>()));
+
+    template<typename Alloc, typename U>
+    using rebind_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+#ifndef CONV_NO_ALLOC
+    // convert any string to a std::basic_string<char>, one code unit per char
     //=====================================
-    [[nodiscard]] static bool wstr_to_str(const std::wstring_view& view, std::string& str) {
+    template<typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static bool narrow_str(const std::basic_string_view<CharT>& view, std::basic_string<char, Traits, Alloc>& str) {
+        CONV_STAT(count_growth(str, view.size());)
         try {
             str.reserve(view.size());
         }
@@ -38,1185 +196,4563 @@ private:
         {
             return false;
         }
-        for (wchar_t c : view)
+        for (CharT c : view)
             str += (char)c;
         return true;
     }
-    [[nodiscard]] static bool wstr_to_str(const std::wstring& wstr, std::string& str) {
-        try {
-            str.reserve(wstr.size());
+#endif
+    // narrow wide code units for parsing without allocating, a code unit
+    // outside ASCII becomes DEL so it can never be taken for a digit
+    template<typename CharT>
+    [[nodiscard]] static char narrow_char(CharT c) {
+        return (std::uint32_t)(std::make_unsigned_t<CharT>)c < 0x80 ? (char)c : '\x7f';
+    }
+    // std::from_chars_result for any character type
+    template<typename CharT>
+    struct scan_result
+    {
+        const CharT* ptr;
+        std::errc ec;
+    };
+    // leading zeros are dropped, so a digit run that does not fit in the
+    // buffer has more than 64 significant digits and is out of range with
+    // or without the cut
+    template<typename CharT, typename T, typename Base>
+    [[nodiscard]] static scan_result<CharT> wide_to_num(const CharT* first, const CharT* last, T& num, Base base) {
+        const CharT* const start = first;
+        if (base == 16 && last - first > 2 && first[0] == '0' && (first[1] == 'X' || first[1] == 'x'))
+            first += 2;
+        char buf[80];
+        size_t len = 0;
+        if (first != last && *first == '-')
+        {
+            buf[len++] = '-';
+            ++first;
         }
-        catch (std::bad_alloc&)
+        while (last - first > 1 && first[0] == '0' && first[1] == '0')
+            ++first;
+        const CharT* const digits = first - len;
+        for (; first != last && len < sizeof(buf); ++first)
+            buf[len++] = narrow_char(*first);
+
+        const auto ret = int_from_chars(buf, buf + len, num, base);
+        if (ret.ec == std::errc::invalid_argument)
+            return { start, ret.ec };
+        // the code units map one to one to buf after the sign
+        const CharT* end = digits + (ret.ptr - buf);
+        if (ret.ptr == buf + len)
+        {
+            while (end != last && constexpr_digit(*end) < (unsigned)base)
+                ++end;
+        }
+        return { end, ret.ec };
+    }
+    // text to float without std::from_chars(), which older standard
+    // libraries lack for floating point. The result is correctly rounded:
+    // decimal text takes the Clinger fast path when the mantissa and the
+    // power of ten are both exact, then the Eisel-Lemire algorithm, and
+    // an exact big decimal for the rare input those two cannot round.
+    //===================================
+    template<typename T>
+    struct binary_format
+    {
+        static constexpr bool is_double = std::is_same_v<T, double>;
+        static constexpr int mantissa_bits = is_double ? 52 : 23;
+        static constexpr int exponent_bits = is_double ? 11 : 8;
+        static constexpr int minimum_exponent = is_double ? -1023 : -127;
+        static constexpr int infinite_power = is_double ? 0x7FF : 0xFF;
+        // below and above these powers of ten any 19 digits are 0 or inf
+        static constexpr int smallest_power_of_ten = is_double ? -342 : -65;
+        static constexpr int largest_power_of_ten = is_double ? 308 : 38;
+        // the powers where w * 10^q can land exactly halfway
+        static constexpr int min_round_to_even = is_double ? -4 : -17;
+        static constexpr int max_round_to_even = is_double ? 23 : 10;
+        // the powers of ten a float holds exactly
+        static constexpr int max_exact_power = is_double ? 22 : 10;
+        static constexpr std::uint64_t max_exact_mantissa = std::uint64_t(2) << mantissa_bits;
+        using bits_type = std::conditional_t<is_double, std::uint64_t, std::uint32_t>;
+    };
+    // a float before it is packed: the fraction bits without the implicit
+    // one, and the biased exponent. power2 < 0 asks for the fallback.
+    struct adjusted_mantissa
+    {
+        std::uint64_t mantissa;
+        int power2;
+        [[nodiscard]] bool operator==(const adjusted_mantissa& other) const {
+            return mantissa == other.mantissa && power2 == other.power2;
+        }
+    };
+    // decimal float text split by scan_decimal()
+    template<typename CharT>
+    struct decimal_text
+    {
+        std::uint64_t mantissa;   // the first 19 significant digits
+        std::int64_t exponent;    // the value is mantissa * 10^exponent
+        bool truncated;           // nonzero digits follow the first 19
+        const CharT* int_first;   // the digits for the exact fallback
+        const CharT* int_last;
+        const CharT* frac_first;
+        const CharT* frac_last;
+        std::int64_t exp_number;  // the written exponent
+        const CharT* end;
+        CharT group;              // between integer digits, 0 for none
+    };
+    struct value128
+    {
+        std::uint64_t low;
+        std::uint64_t high;
+    };
+    [[nodiscard]] static value128 full_multiplication(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 r = (unsigned __int128)a * b;
+        return { (std::uint64_t)r, (std::uint64_t)(r >> 64) };
+#elif defined(_MSC_VER) && defined(CONV_SIMD_X86) && defined(_M_X64)
+        value128 r;
+        r.low = _umul128(a, b, &r.high);
+        return r;
+#else
+        const std::uint64_t lo_lo = (a & 0xFFFFFFFFu) * (b & 0xFFFFFFFFu);
+        const std::uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFFu);
+        const std::uint64_t lo_hi = (a & 0xFFFFFFFFu) * (b >> 32);
+        const std::uint64_t hi_hi = (a >> 32) * (b >> 32);
+        const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+        return { (cross << 32) | (lo_lo & 0xFFFFFFFFu), (hi_lo >> 32) + (cross >> 32) + hi_hi };
+#endif
+    }
+    [[nodiscard]] static constexpr int leading_zeros(std::uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int n = 0;
+        for (; !(x & 0xFFFFFFFF00000000ull); x <<= 32) n += 32;
+        for (; !(x & 0x8000000000000000ull); x <<= 1) ++n;
+        return n;
+#else
+        return __builtin_clzll(x);
+#endif
+    }
+    template<typename CharT>
+    [[nodiscard]] static bool is_digit(CharT c) {
+        return (std::uint32_t)(std::make_unsigned_t<CharT>)c - '0' <= 9;
+    }
+    [[nodiscard]] static bool is_eight_digits(const char* p) {
+        std::uint64_t val;
+        memcpy(&val, p, sizeof(val));
+        return ((val & 0xF0F0F0F0F0F0F0F0ull) | (((val + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+    // value of 8 digits, first digit in the lowest byte
+    [[nodiscard]] static std::uint32_t parse_eight_digits(const char* p) {
+        std::uint64_t val;
+        memcpy(&val, p, sizeof(val));
+        val -= 0x3030303030303030ull;
+        val = (val * 10) + (val >> 8);
+        val = (((val & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+            + (((val >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+        return (std::uint32_t)val;
+    }
+    // the digits at p, 8 at a time in char text where the byte order
+    // allows it
+    template<typename CharT>
+    [[nodiscard]] static const CharT* scan_digits(const CharT* p, const CharT* last, std::uint64_t& i) {
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        if constexpr (sizeof(CharT) == 1)
+        {
+            while (last - p >= 8 && is_eight_digits((const char*)p))
+            {
+                i = i * 100000000 + parse_eight_digits((const char*)p);
+                p += 8;
+            }
+        }
+#endif
+        for (; p != last && is_digit(*p); ++p)
+            i = i * 10 + (std::uint64_t)(*p - '0');
+        return p;
+    }
+    // split [p, last) into digits and exponent the way fmt spells a
+    // float. The 19 digit mantissa wraps while scanning and is redone
+    // from the text when there are more digits than that. A group
+    // character is taken after 1 to 3 leading digits and before each
+    // following group of exactly 3. Wide text is read in place.
+    template<typename CharT, typename Format>
+    [[nodiscard]] static bool scan_decimal(const CharT* p, const CharT* last, Format fmt, decimal_text<CharT>& dec, const punctuation& punct) {
+        const CharT group = (CharT)(unsigned char)punct.group;
+        const CharT decimal = (CharT)(unsigned char)punct.decimal;
+        std::uint64_t i = 0;
+        dec.int_first = p;
+        p = scan_digits(p, last, i);
+        std::int64_t separators = 0;
+        if (group != CharT() && p != dec.int_first && p - dec.int_first <= 3)
         {
+            for (; last - p >= 4 && p[0] == group && is_digit(p[1]) && is_digit(p[2]) && is_digit(p[3])
+                && (last - p == 4 || !is_digit(p[4])); p += 4, ++separators)
+                i = i * 1000 + (std::uint64_t)((p[1] - '0') * 100 + (p[2] - '0') * 10 + (p[3] - '0'));
+        }
+        dec.group = group;
+        dec.int_last = dec.frac_first = dec.frac_last = p;
+        if (p != last && *p == decimal)
+        {
+            dec.frac_first = p + 1;
+            p = dec.frac_last = scan_digits(p + 1, last, i);
+        }
+        const std::int64_t digit_count = (dec.int_last - dec.int_first - separators) + (dec.frac_last - dec.frac_first);
+        if (digit_count == 0)
             return false;
+
+        const bool allow_exp = (fmt & std::chars_format::scientific) == std::chars_format::scientific;
+        const bool need_exp = allow_exp && (fmt & std::chars_format::fixed) != std::chars_format::fixed;
+        std::int64_t exp_number = 0;
+        if (allow_exp && p != last && (*p == 'e' || *p == 'E'))
+        {
+            const CharT* q = p + 1;
+            const bool exp_neg = q != last && *q == '-';
+            if (q != last && (*q == '-' || *q == '+'))
+                ++q;
+            if (q == last || !is_digit(*q))
+            {
+                if (need_exp)
+                    return false;
+            }
+            else
+            {
+                // saturated, a bigger exponent is 0 or inf all the same
+                for (; q != last && is_digit(*q); ++q)
+                {
+                    if (exp_number < 0x10000000)
+                        exp_number = exp_number * 10 + (*q - '0');
+                }
+                exp_number = exp_neg ? -exp_number : exp_number;
+                p = q;
+            }
+        }
+        else if (need_exp)
+            return false;
+
+        dec.mantissa = i;
+        dec.exponent = exp_number - (dec.frac_last - dec.frac_first);
+        dec.truncated = false;
+        dec.exp_number = exp_number;
+        dec.end = p;
+        if (digit_count > 19)
+        {
+            // keep the first 19 digits after the leading zeros
+            i = 0;
+            int n = 0;
+            std::int64_t exponent = exp_number;
+            bool truncated = false;
+            for (const CharT* s = dec.int_first; s != dec.int_last; ++s)
+            {
+                if (*s == dec.group)
+                    continue;
+                if (n < 19)
+                {
+                    i = i * 10 + (std::uint64_t)(*s - '0');
+                    n += (i != 0);
+                }
+                else
+                {
+                    ++exponent;
+                    truncated = truncated || *s != '0';
+                }
+            }
+            for (const CharT* s = dec.frac_first; s != dec.frac_last; ++s)
+            {
+                if (n < 19)
+                {
+                    i = i * 10 + (std::uint64_t)(*s - '0');
+                    n += (i != 0);
+                    --exponent;
+                }
+                else
+                    truncated = truncated || *s != '0';
+            }
+            dec.mantissa = i;
+            dec.exponent = exponent;
+            dec.truncated = truncated;
         }
-        for (wchar_t c : wstr)
-            str += (char)c;
         return true;
     }
-    [[nodiscard]] static bool wstr_to_str(const wchar_t* wstr, std::string& str) {
-        std::size_t len = wcslen(wstr);
-        try {
-            str.reserve(len);
+    // 128 bit approximations of 5^q for q in [-342, 324], the highest
+    // bit set. Powers from zero are truncated, powers below zero are
+    // rounded up reciprocals, truncated below -27. Formatting needs the
+    // powers above 308.
+    static constexpr int smallest_power_of_five = -342;
+    static constexpr std::uint64_t power_of_five_128[] = {
+        0xeef453d6923bd65a, 0x113faa2906a13b3f, 0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+        0xbaaee17fa23ebf76, 0x5d79bcf00d2df649, 0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+        0x91d8a02bb6c10594, 0x79071b9b8a4be869, 0xb64ec836a47146f9, 0x9748e2826cdee284,
+        0xe3e27a444d8d98b7, 0xfd1b1b2308169b25, 0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+        0xb208ef855c969f4f, 0xbdbd2d335e51a935, 0xde8b2b66b3bc4723, 0xad2c788035e61382,
+        0x8b16fb203055ac76, 0x4c3bcb5021afcc31, 0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+        0xd953e8624b85dd78, 0xd71d6dad34a2af0d, 0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+        0xa9c98d8ccb009506, 0x680efdaf511f18c2, 0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+        0x84a57695fe98746d, 0x014bb630f7604b57, 0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+        0xcf42894a5dce35ea, 0x52064cac828675b9, 0x818995ce7aa0e1b2, 0x7343efebd1940993,
+        0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8, 0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+        0xfd00b897478238d0, 0x8920b098955522b4, 0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+        0xc5a890362fddbc62, 0xeb2189f734aa831d, 0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+        0x9a6bb0aa55653b2d, 0x47b233c92125366e, 0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+        0xf148440a256e2c76, 0xc00670ea43ca250d, 0x96cd2a865764dbca, 0x380406926a5e5728,
+        0xbc807527ed3e12bc, 0xc605083704f5ecf2, 0xeba09271e88d976b, 0xf7864a44c633682e,
+        0x93445b8731587ea3, 0x7ab3ee6afbe0211d, 0xb8157268fdae9e4c, 0x5960ea05bad82964,
+        0xe61acf033d1a45df, 0x6fb92487298e33bd, 0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+        0xb3c4f1ba87bc8696, 0x8f48a4899877186c, 0xe0b62e2929aba83c, 0x331acdabfe94de87,
+        0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, 0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+        0xdb71e91432b1a24a, 0xc9e82cd9f69d6150, 0x892731ac9faf056e, 0xbe311c083a225cd2,
+        0xab70fe17c79ac6ca, 0x6dbd630a48aaf406, 0xd64d3d9db981787d, 0x092cbbccdad5b108,
+        0x85f0468293f0eb4e, 0x25bbf56008c58ea5, 0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+        0xd1476e2c07286faa, 0x1af5af660db4aee1, 0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+        0xa37fce126597973c, 0xe50ff107bab528a0, 0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+        0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a, 0x9faacf3df73609b1, 0x77b191618c54e9ac,
+        0xc795830d75038c1d, 0xd59df5b9ef6a2417, 0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+        0x9becce62836ac577, 0x4ee367f9430aec32, 0xc2e801fb244576d5, 0x229c41f793cda73f,
+        0xf3a20279ed56d48a, 0x6b43527578c1110f, 0x9845418c345644d6, 0x830a13896b78aaa9,
+        0xbe5691ef416bd60c, 0x23cc986bc656d553, 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+        0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9, 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+        0xe858ad248f5c22c9, 0xd1b3400f8f9cff68, 0x91376c36d99995be, 0x23100809b9c21fa1,
+        0xb58547448ffffb2d, 0xabd40a0c2832a78a, 0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+        0x8dd01fad907ffc3b, 0xae3da7d97f6792e3, 0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+        0xdd95317f31c7fa1d, 0x40405643d711d583, 0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+        0xad1c8eab5ee43b66, 0xda3243650005eecf, 0xd863b256369d4a40, 0x90bed43e40076a82,
+        0x873e4f75e2224e68, 0x5a7744a6e804a291, 0xa90de3535aaae202, 0x711515d0a205cb36,
+        0xd3515c2831559a83, 0x0d5a5b44ca873e03, 0x8412d9991ed58091, 0xe858790afe9486c2,
+        0xa5178fff668ae0b6, 0x626e974dbe39a872, 0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+        0x80fa687f881c7f8e, 0x7ce66634bc9d0b99, 0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+        0xc987434744ac874e, 0xa327ffb266b56220, 0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+        0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9, 0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+        0xf6019da07f549b2b, 0x7e2a53a146606a48, 0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+        0xc0314325637a1939, 0xfa911155fefb5308, 0xf03d93eebc589f88, 0x793555ab7eba27ca,
+        0x96267c7535b763b5, 0x4bc1558b2f3458de, 0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+        0xea9c227723ee8bcb, 0x465e15a979c1cadc, 0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+        0xb749faed14125d36, 0xcef980ec671f667b, 0xe51c79a85916f484, 0x82b7e12780e7401a,
+        0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810, 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+        0xdfbdcece67006ac9, 0x67a791e093e1d49a, 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+        0xaecc49914078536d, 0x58fae9f773886e18, 0xda7f5bf590966848, 0xaf39a475506a899e,
+        0x888f99797a5e012d, 0x6d8406c952429603, 0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+        0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64, 0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+        0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e, 0xd0601d8efc57b08b, 0xf13b94daf124da26,
+        0x823c12795db6ce57, 0x76c53d08d6b70858, 0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+        0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09, 0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+        0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf, 0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+        0xf867241c8cc6d4c0, 0xc30163d203c94b62, 0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+        0xc21094364dfb5636, 0x985915fc12f542e4, 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+        0x979cf3ca6cec5b5a, 0xa705992ceecf9c42, 0xbd8430bd08277231, 0x50c6ff782a838353,
+        0xece53cec4a314ebd, 0xa4f8bf5635246428, 0x940f4613ae5ed136, 0x871b7795e136be99,
+        0xb913179899f68584, 0x28e2557b59846e3f, 0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+        0x9096ea6f3848984f, 0x3ff0d2c85def7621, 0xb4bca50b065abe63, 0x0fed077a756b53a9,
+        0xe1ebce4dc7f16dfb, 0xd3e8495912c62894, 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+        0xb080392cc4349dec, 0xbd8d794d96aacfb3, 0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+        0x89e42caaf9491b60, 0xf41686c49db57244, 0xac5d37d5b79b6239, 0x311c2875c522ced5,
+        0xd77485cb25823ac7, 0x7d633293366b828b, 0x86a8d39ef77164bc, 0xae5dff9c02033197,
+        0xa8530886b54dbdeb, 0xd9f57f830283fdfc, 0xd267caa862a12d66, 0xd072df63c324fd7b,
+        0x8380dea93da4bc60, 0x4247cb9e59f71e6d, 0xa46116538d0deb78, 0x52d9be85f074e608,
+        0xcd795be870516656, 0x67902e276c921f8b, 0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+        0xa086cfcd97bf97f3, 0x80e8a40eccd228a4, 0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+        0xfad2a4b13d1b5d6c, 0x796b805720085f81, 0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+        0xc3f490aa77bd60fc, 0xbedbfc4411068a9c, 0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+        0x991711052d8bf3c5, 0x751bdd152d4d1c4a, 0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+        0xef340a98172aace4, 0x86fb897116c87c34, 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+        0xbae0a846d2195712, 0x8974836059cca109, 0xe998d258869facd7, 0x2bd1a438703fc94b,
+        0x91ff83775423cc06, 0x7b6306a34627ddcf, 0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+        0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, 0x8e938662882af53e, 0x547eb47b7282ee9c,
+        0xb23867fb2a35b28d, 0xe99e619a4f23aa43, 0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+        0x8b3c113c38f9f37e, 0xde83bc408dd3dd04, 0xae0b158b4738705e, 0x9624ab50b148d445,
+        0xd98ddaee19068c76, 0x3badd624dd9b0957, 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+        0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c, 0xd47487cc8470652b, 0x7647c3200069671f,
+        0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073, 0xa5fb0a17c777cf09, 0xf468107100525890,
+        0xcf79cc9db955c2cc, 0x7182148d4066eeb4, 0x81ac1fe293d599bf, 0xc6f14cd848405530,
+        0xa21727db38cb002f, 0xb8ada00e5a506a7c, 0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+        0xfd442e4688bd304a, 0x908f4a166d1da663, 0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+        0xc5dd44271ad3cdba, 0x40eff1e1853f29fd, 0xf7549530e188c128, 0xd12bee59e68ef47c,
+        0x9a94dd3e8cf578b9, 0x82bb74f8301958ce, 0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+        0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1, 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+        0xbcb2b812db11a5de, 0x7415d448f6b6f0e7, 0xebdf661791d60f56, 0x111b495b3464ad21,
+        0x936b9fcebb25c995, 0xcab10dd900beec34, 0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+        0xe65829b3046b0afa, 0x0cb4a5a3112a5112, 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+        0xb3f4e093db73a093, 0x59ed216765690f56, 0xe0f218b8d25088b8, 0x306869c13ec3532c,
+        0x8c974f7383725573, 0x1e414218c73a13fb, 0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+        0xdbac6c247d62a583, 0xdf45f746b74abf39, 0x894bc396ce5da772, 0x6b8bba8c328eb783,
+        0xab9eb47c81f5114f, 0x066ea92f3f326564, 0xd686619ba27255a2, 0xc80a537b0efefebd,
+        0x8613fd0145877585, 0xbd06742ce95f5f36, 0xa798fc4196e952e7, 0x2c48113823b73704,
+        0xd17f3b51fca3a7a0, 0xf75a15862ca504c5, 0x82ef85133de648c4, 0x9a984d73dbe722fb,
+        0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba, 0xcc963fee10b7d1b3, 0x318df905079926a8,
+        0xffbbcfe994e5c61f, 0xfdf17746497f7052, 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+        0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0, 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+        0x9c1661a651213e2d, 0x06bea10ca65c084e, 0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+        0xf3e2f893dec3f126, 0x5a89dba3c3efccfa, 0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+        0xbe89523386091465, 0xf6bbb397f1135823, 0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+        0x94db483840b717ef, 0xa8c2a44eb4571cdc, 0xba121a4650e4ddeb, 0x92f34d62616ce413,
+        0xe896a0d7e51e1566, 0x77b020baf9c81d17, 0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+        0xb5b5ada8aaff80b8, 0x0d819992132456ba, 0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+        0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1, 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+        0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde, 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+        0xad4ab7112eb3929d, 0x86c16c98d2c953c6, 0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+        0x87625f056c7c4a8b, 0x11471cd764ad4972, 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+        0xd389b47879823479, 0x4aff1d108d4ec2c3, 0x843610cb4bf160cb, 0xcedf722a585139ba,
+        0xa54394fe1eedb8fe, 0xc2974eb4ee658828, 0xce947a3da6a9273e, 0x733d226229feea32,
+        0x811ccc668829b887, 0x0806357d5a3f525f, 0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+        0xc9bcff6034c13052, 0xfc89b393dd02f0b5, 0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+        0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, 0xc5029163f384a931, 0x0a9e795e65d4df11,
+        0xf64335bcf065d37d, 0x4d4617b5ff4a16d5, 0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+        0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6, 0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+        0x964e858c91ba2655, 0x3a6a07f8d510f86f, 0xbbe226efb628afea, 0x890489f70a55368b,
+        0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e, 0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+        0xb77ada0617e3bbcb, 0x09ce6ebb40173744, 0xe55990879ddcaabd, 0xcc420a6a101d0515,
+        0x8f57fa54c2a9eab6, 0x9fa946824a12232d, 0xb32df8e9f3546564, 0x47939822dc96abf9,
+        0xdff9772470297ebd, 0x59787e2b93bc56f7, 0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+        0xaefae51477a06b03, 0xede622920b6b23f1, 0xdab99e59958885c4, 0xe95fab368e45eced,
+        0x88b402f7fd75539b, 0x11dbcb0218ebb414, 0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+        0xd59944a37c0752a2, 0x4be76d3346f0495f, 0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+        0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952, 0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+        0x825ecc24c873782f, 0x8ed400668c0c28c8, 0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+        0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9, 0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+        0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9, 0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+        0xf8a95fcf88747d94, 0x75a44c6397ce912a, 0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+        0xc24452da229b021b, 0xfbe85badce996168, 0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+        0x97c560ba6b0919a5, 0xdccd879fc967d41a, 0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+        0xed246723473e3813, 0x290123e9aab23b68, 0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+        0xb94470938fa89bce, 0xf808e40e8d5b3e69, 0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+        0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2, 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+        0xe2280b6c20dd5232, 0x25c6da63c38de1b0, 0x8d590723948a535f, 0x579c487e5a38ad0e,
+        0xb0af48ec79ace837, 0x2d835a9df0c6d851, 0xdcdb1b2798182244, 0xf8e431456cf88e65,
+        0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff, 0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+        0xd7adf884aa879177, 0x5b0ed81dcc6abb0f, 0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+        0xa87fea27a539e9a5, 0x3f2398d747b36224, 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+        0x83a3eeeef9153e89, 0x1953cf68300424ac, 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+        0xcdb02555653131b6, 0x3792f412cb06794d, 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+        0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, 0xc8de047564d20a8b, 0xf245825a5a445275,
+        0xfb158592be068d2e, 0xeed6e2f0f0d56712, 0x9ced737bb6c4183d, 0x55464dd69685606b,
+        0xc428d05aa4751e4c, 0xaa97e14c3c26b886, 0xf53304714d9265df, 0xd53dd99f4b3066a8,
+        0x993fe2c6d07b7fab, 0xe546a8038efe4029, 0xbf8fdb78849a5f96, 0xde98520472bdd033,
+        0xef73d256a5c0f77c, 0x963e66858f6d4440, 0x95a8637627989aad, 0xdde7001379a44aa8,
+        0xbb127c53b17ec159, 0x5560c018580d5d52, 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+        0x9226712162ab070d, 0xcab3961304ca70e8, 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+        0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+        0xb267ed1940f1c61c, 0x55f038b237591ed3, 0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+        0x8b61313bbabce2c6, 0x2323ac4b3b3da015, 0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+        0xd9c7dced53c72255, 0x96e7bd358c904a21, 0x881cea14545c7575, 0x7e50d64177da2e54,
+        0xaa242499697392d2, 0xdde50bd1d5d0b9e9, 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+        0x84ec3c97da624ab4, 0xbd5af13bef0b113e, 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+        0xcfb11ead453994ba, 0x67de18eda5814af2, 0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+        0xa2425ff75e14fc31, 0xa1258379a94d028d, 0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+        0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, 0x9e74d1b791e07e48, 0x775ea264cf55347e,
+        0xc612062576589dda, 0x95364afe032a819e, 0xf79687aed3eec551, 0x3a83ddbd83f52205,
+        0x9abe14cd44753b52, 0xc4926a9672793543, 0xc16d9a0095928a27, 0x75b7053c0f178294,
+        0xf1c90080baf72cb1, 0x5324c68b12dd6339, 0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+        0xbce5086492111aea, 0x88f4bb1ca6bcf585, 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+        0x9392ee8e921d5d07, 0x3aff322e62439fd0, 0xb877aa3236a4b449, 0x09befeb9fad487c3,
+        0xe69594bec44de15b, 0x4c2ebe687989a9b4, 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+        0xb424dc35095cd80f, 0x538484c19ef38c95, 0xe12e13424bb40e13, 0x2865a5f206b06fba,
+        0x8cbccc096f5088cb, 0xf93f87b7442e45d4, 0xafebff0bcb24aafe, 0xf78f69a51539d749,
+        0xdbe6fecebdedd5be, 0xb573440e5a884d1c, 0x89705f4136b4a597, 0x31680a88f8953031,
+        0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, 0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+        0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, 0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+        0xd1b71758e219652b, 0xd3c36113404ea4a9, 0x83126e978d4fdf3b, 0x645a1cac083126ea,
+        0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, 0xcccccccccccccccc, 0xcccccccccccccccd,
+        0x8000000000000000, 0x0000000000000000, 0xa000000000000000, 0x0000000000000000,
+        0xc800000000000000, 0x0000000000000000, 0xfa00000000000000, 0x0000000000000000,
+        0x9c40000000000000, 0x0000000000000000, 0xc350000000000000, 0x0000000000000000,
+        0xf424000000000000, 0x0000000000000000, 0x9896800000000000, 0x0000000000000000,
+        0xbebc200000000000, 0x0000000000000000, 0xee6b280000000000, 0x0000000000000000,
+        0x9502f90000000000, 0x0000000000000000, 0xba43b74000000000, 0x0000000000000000,
+        0xe8d4a51000000000, 0x0000000000000000, 0x9184e72a00000000, 0x0000000000000000,
+        0xb5e620f480000000, 0x0000000000000000, 0xe35fa931a0000000, 0x0000000000000000,
+        0x8e1bc9bf04000000, 0x0000000000000000, 0xb1a2bc2ec5000000, 0x0000000000000000,
+        0xde0b6b3a76400000, 0x0000000000000000, 0x8ac7230489e80000, 0x0000000000000000,
+        0xad78ebc5ac620000, 0x0000000000000000, 0xd8d726b7177a8000, 0x0000000000000000,
+        0x878678326eac9000, 0x0000000000000000, 0xa968163f0a57b400, 0x0000000000000000,
+        0xd3c21bcecceda100, 0x0000000000000000, 0x84595161401484a0, 0x0000000000000000,
+        0xa56fa5b99019a5c8, 0x0000000000000000, 0xcecb8f27f4200f3a, 0x0000000000000000,
+        0x813f3978f8940984, 0x4000000000000000, 0xa18f07d736b90be5, 0x5000000000000000,
+        0xc9f2c9cd04674ede, 0xa400000000000000, 0xfc6f7c4045812296, 0x4d00000000000000,
+        0x9dc5ada82b70b59d, 0xf020000000000000, 0xc5371912364ce305, 0x6c28000000000000,
+        0xf684df56c3e01bc6, 0xc732000000000000, 0x9a130b963a6c115c, 0x3c7f400000000000,
+        0xc097ce7bc90715b3, 0x4b9f100000000000, 0xf0bdc21abb48db20, 0x1e86d40000000000,
+        0x96769950b50d88f4, 0x1314448000000000, 0xbc143fa4e250eb31, 0x17d955a000000000,
+        0xeb194f8e1ae525fd, 0x5dcfab0800000000, 0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+        0xb7abc627050305ad, 0xf14a3d9e40000000, 0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+        0x8f7e32ce7bea5c6f, 0xe4820023a2000000, 0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+        0xe0352f62a19e306e, 0xd50b2037ad200000, 0x8c213d9da502de45, 0x4526f422cc340000,
+        0xaf298d050e4395d6, 0x9670b12b7f410000, 0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+        0x88d8762bf324cd0f, 0xa5880a69fb6ac800, 0xab0e93b6efee0053, 0x8eea0d047a457a00,
+        0xd5d238a4abe98068, 0x72a4904598d6d880, 0x85a36366eb71f041, 0x47a6da2b7f864750,
+        0xa70c3c40a64e6c51, 0x999090b65f67d924, 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+        0x82818f1281ed449f, 0xbff8f10e7a8921a4, 0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+        0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490, 0xfee50b7025c36a08, 0x02f236d04753d5b4,
+        0x9f4f2726179a2245, 0x01d762422c946590, 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+        0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2, 0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+        0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, 0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+        0x97edd871cfda3a56, 0x97758bf0e3cbb5ac, 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+        0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd, 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+        0xb975d6b6ee39e436, 0xb3e2fd538e122b44, 0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+        0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd, 0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+        0xe264589a4dcdab14, 0xc696963c7eed2dd1, 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+        0xb0de65388cc8ada8, 0x3b25a55f43294bcb, 0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+        0x8a2dbf142dfcc7ab, 0x6e3569326c784337, 0xacb92ed9397bf996, 0x49c2c37f07965404,
+        0xd7e77a8f87daf7fb, 0xdc33745ec97be906, 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+        0xa8acd7c0222311bc, 0xc40832ea0d68ce0c, 0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+        0x83c7088e1aab65db, 0x792667c6da79e0fa, 0xa4b8cab1a1563f52, 0x577001b891185938,
+        0xcde6fd5e09abcf26, 0xed4c0226b55e6f86, 0x80b05e5ac60b6178, 0x544f8158315b05b4,
+        0xa0dc75f1778e39d6, 0x696361ae3db1c721, 0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+        0xfb5878494ace3a5f, 0x04ab48a04065c723, 0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+        0xc45d1df942711d9a, 0x3ba5d0bd324f8394, 0xf5746577930d6500, 0xca8f44ec7ee36479,
+        0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb, 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+        0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, 0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+        0xbb445da9ca61281f, 0x2a8a6e45ae8edc97, 0xea1575143cf97226, 0xf52d09d71a3293bd,
+        0x924d692ca61be758, 0x593c2626705f9c56, 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+        0xe498f455c38b997a, 0x0b6dfb9c0f956447, 0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+        0xb2977ee300c50fe7, 0x58edec91ec2cb657, 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+        0x8b865b215899f46c, 0xbd79e0d20082ee74, 0xae67f1e9aec07187, 0xecd8590680a3aa11,
+        0xda01ee641a708de9, 0xe80e6f4820cc9495, 0x884134fe908658b2, 0x3109058d147fdcdd,
+        0xaa51823e34a7eede, 0xbd4b46f0599fd415, 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+        0x850fadc09923329e, 0x03e2cf6bc604ddb0, 0xa6539930bf6bff45, 0x84db8346b786151c,
+        0xcfe87f7cef46ff16, 0xe612641865679a63, 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+        0xa26da3999aef7749, 0xe3be5e330f38f09d, 0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+        0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6, 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+        0xc646d63501a1511d, 0xb281e1fd541501b8, 0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+        0x9ae757596946075f, 0x3375788de9b06958, 0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+        0xf209787bb47d6b84, 0xc0678c5dbd23a49a, 0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+        0xbd176620a501fbff, 0xb650e5a93bc3d898, 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+        0x93ba47c980e98cdf, 0xc66f336c36b10137, 0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+        0xe6d3102ad96cec1d, 0xa60dc059157491e5, 0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+        0xb454e4a179dd1877, 0x29babe4598c311fb, 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+        0x8ce2529e2734bb1d, 0x1899e4a65f58660c, 0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+        0xdc21a1171d42645d, 0x76707543f4fa1f73, 0x899504ae72497eba, 0x6a06494a791c53a8,
+        0xabfa45da0edbde69, 0x0487db9d17636892, 0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+        0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2, 0xa7f26836f282b732, 0x8e6cac7768d7141e,
+        0xd1ef0244af2364ff, 0x3207d795430cd926, 0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+        0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, 0xcd036837130890a1, 0x36dba887c37a8c0f,
+        0x802221226be55a64, 0xc2494954da2c9789, 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+        0xc83553c5c8965d3d, 0x6f92829494e5acc7, 0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+        0x9c69a97284b578d7, 0xff2a760414536efb, 0xc38413cf25e2d70d, 0xfef5138519684aba,
+        0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, 0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+        0xbeeefb584aff8603, 0xaafb550ffacfd8fa, 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+        0x952ab45cfa97a0b2, 0xdd945a747bf26183, 0xba756174393d88df, 0x94f971119aeef9e4,
+        0xe912b9d1478ceb17, 0x7a37cd5601aab85d, 0x91abb422ccb812ee, 0xac62e055c10ab33a,
+        0xb616a12b7fe617aa, 0x577b986b314d6009, 0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+        0x8e41ade9fbebc27d, 0x14588f13be847307, 0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+        0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb, 0x8aec23d680043bee, 0x25de7bb9480d5854,
+        0xada72ccc20054ae9, 0xaf561aa79a10ae6a, 0xd910f7ff28069da4, 0x1b2ba1518094da04,
+        0x87aa9aff79042286, 0x90fb44d2f05d0842, 0xa99541bf57452b28, 0x353a1607ac744a53,
+        0xd3fa922f2d1675f2, 0x42889b8997915ce8, 0x847c9b5d7c2e09b7, 0x69956135febada11,
+        0xa59bc234db398c25, 0x43fab9837e699095, 0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+        0x8161afb94b44f57d, 0x1d1be0eebac278f5, 0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+        0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, 0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+        0x9defbf01b061adab, 0x3a0888136afa64a7, 0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+        0xf6c69a72a3989f5b, 0x8aad549e57273d45, 0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+        0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd, 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+        0x969eb7c47859e743, 0x9f644ae5a4b1b325, 0xbc4665b596706114, 0x873d5d9f0dde1fee,
+        0xeb57ff22fc0c7959, 0xa90cb506d155a7ea, 0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+        0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f, 0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+        0x8fa475791a569d10, 0xf96e017d694487bc, 0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+        0xe070f78d3927556a, 0x85bbe253f47b1417, 0x8c469ab843b89562, 0x93956d7478ccec8e,
+        0xaf58416654a6babb, 0x387ac8d1970027b2, 0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+        0x88fcf317f22241e2, 0x441fece3bdf81f03, 0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+        0xd60b3bd56a5586f1, 0x8a71e223d8d3b074, 0x85c7056562757456, 0xf6872d5667844e49,
+        0xa738c6bebb12d16c, 0xb428f8ac016561db, 0xd106f86e69d785c7, 0xe13336d701beba52,
+        0x82a45b450226b39c, 0xecc0024661173473, 0xa34d721642b06084, 0x27f002d7f95d0190,
+        0xcc20ce9bd35c78a5, 0x31ec038df7b441f4, 0xff290242c83396ce, 0x7e67047175a15271,
+        0x9f79a169bd203e41, 0x0f0062c6e984d386, 0xc75809c42c684dd1, 0x52c07b78a3e60868,
+        0xf92e0c3537826145, 0xa7709a56ccdf8a82, 0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+        0xc2abf989935ddbfe, 0x6acff893d00ea435, 0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+        0x98165af37b2153de, 0xc3727a337a8b704a, 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+        0xeda2ee1c7064130c, 0x1162def06f79df73, 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+        0xb9a74a0637ce2ee1, 0x6d953e2bd7173692, 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+        0x910ab1d4db9914a0, 0x1d9c9892400a22a2, 0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+        0xe2a0b5dc971f303a, 0x2e44ae64840fd61d, 0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+        0xb10d8e1456105dad, 0x7425a83e872c5f47, 0xdd50f1996b947518, 0xd12f124e28f77719,
+        0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, 0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+        0xd8210befd30efa5a, 0x3c47f7e05401aa4e, 0x8714a775e3e95c78, 0x65acfaec34810a71,
+        0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, 0xd31045a8341ca07c, 0x1ede48111209a050,
+        0x83ea2b892091e44d, 0x934aed0aab460432, 0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+        0xce1de40642e3f4b9, 0x36251260ab9d668e, 0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+        0xa1075a24e4421730, 0xb24cf65b8612f81f, 0xc94930ae1d529cfc, 0xdee033f26797b627,
+        0xfb9b7cd9a4a7443c, 0x169840ef017da3b1, 0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+        0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2, 0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+        0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, 0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+        0xeff394dcff8a948e, 0xddfc4b4cef07f5b0, 0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+        0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1, 0xea53df5fd18d5513, 0x84c86189216dc5ed,
+        0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4, 0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+        0xe4d5e82392a40515, 0x0fabaf3feaa5334a, 0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+        0xb2c71d5bca9023f8, 0x743e20e9ef511012, 0xdf78e4b2bd342cf6, 0x914da9246b255416,
+        0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e, 0xae9672aba3d0c320, 0xa184ac2473b529b1,
+        0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e, 0x8865899617fb1871, 0x7e2fa67c7a658892,
+        0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, 0xd51ea6fa85785631, 0x552a74227f3ea565,
+        0x8533285c936b35de, 0xd53a88958f87275f, 0xa67ff273b8460356, 0x8a892abaf368f137,
+        0xd01fef10a657842c, 0x2d2b7569b0432d85, 0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+        0xa298f2c501f45f42, 0x8349f3ba91b47b8f, 0xcb3f2f7642717713, 0x241c70a936219a73,
+        0xfe0efb53d30dd4d7, 0xed238cd383aa0110, 0x9ec95d1463e8a506, 0xf4363804324a40aa,
+        0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, 0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+        0x9b10a4e5e9913128, 0xca7cf2b4191c8326, 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+        0xf24a01a73cf2dccf, 0xbc633b39673c8cec, 0x976e41088617ca01, 0xd5be0503e085d813,
+        0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18, 0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+        0x93e1ab8252f33b45, 0xcabb90e5c942b503, 0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+        0xe7109bfba19c0c9d, 0x0cc512670a783ad4, 0x906a617d450187e2, 0x27fb2b80668b24c5,
+        0xb484f9dc9641e9da, 0xb1f9f660802dedf6, 0xe1a63853bbd26451, 0x5e7873f8a0396973,
+        0x8d07e33455637eb2, 0xdb0b487b6423e1e8, 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+        0xdc5c5301c56b75f7, 0x7641a140cc7810fb, 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+        0xac2820d9623bf429, 0x546345fa9fbdcd44, 0xd732290fbacaf133, 0xa97c177947ad4095,
+        0x867f59a9d4bed6c0, 0x49ed8eabcccc485d, 0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+        0xd226fc195c6a2f8c, 0x73832eec6fff3111, 0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+        0xa42e74f3d032f525, 0xba3e7ca8b77f5e55, 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+        0x80444b5e7aa7cf85, 0x7980d163cf5b81b3, 0xa0555e361951c366, 0xd7e105bcc332621f,
+        0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7, 0xfa856334878fc150, 0xb14f98f6f0feb951,
+        0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3, 0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+        0xf4a642e14c6262c8, 0xcd27bb612758c0fa, 0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+        0xbf21e44003acdd2c, 0xe0470a63e6bd56c3, 0xeeea5d5004981478, 0x1858ccfce06cac74,
+        0x95527a5202df0ccb, 0x0f37801e0c43ebc8, 0xbaa718e68396cffd, 0xd30560258f54e6ba,
+        0xe950df20247c83fd, 0x47c6b82ef32a2069, 0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+        0xb6472e511c81471d, 0xe0133fe4adf8e952, 0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+        0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648, 0xb201833b35d63f73, 0x2cd2cc6551e513da,
+        0xde81e40a034bcf4f, 0xf8077f7ea65e58d1, 0x8b112e86420f6191, 0xfb04afaf27faf782,
+        0xadd57a27d29339f6, 0x79c5db9af1f9b563, 0xd94ad8b1c7380874, 0x18375281ae7822bc,
+        0x87cec76f1c830548, 0x8f2293910d0b15b5, 0xa9c2794ae3a3c69a, 0xb2eb3875504ddb22,
+        0xd433179d9c8cb841, 0x5fa60692a46151eb, 0x849feec281d7f328, 0xdbc7c41ba6bcd333,
+        0xa5c7ea73224deff3, 0x12b9b522906c0800, 0xcf39e50feae16bef, 0xd768226b34870a00,
+        0x81842f29f2cce375, 0xe6a1158300d46640, 0xa1e53af46f801c53, 0x60495ae3c1097fd0,
+        0xca5e89b18b602368, 0x385bb19cb14bdfc4, 0xfcf62c1dee382c42, 0x46729e03dd9ed7b5,
+        0x9e19db92b4e31ba9, 0x6c07a2c26a8346d1
+    };
+    // w * 5^q with at least bit_precision correct high bits
+    template<int bit_precision>
+    [[nodiscard]] static value128 compute_product_approximation(std::int64_t q, std::uint64_t w) {
+        const int index = 2 * (int)(q - smallest_power_of_five);
+        value128 first = full_multiplication(w, power_of_five_128[index]);
+        constexpr std::uint64_t precision_mask = bit_precision < 64 ? (UINT64_MAX >> bit_precision) : UINT64_MAX;
+        if ((first.high & precision_mask) == precision_mask)
+        {
+            const value128 second = full_multiplication(w, power_of_five_128[index + 1]);
+            first.low += second.high;
+            if (second.high > first.low)
+                first.high++;
         }
-        catch (std::bad_alloc&)
+        return first;
+    }
+    // w * 10^q rounded to T with the Eisel-Lemire algorithm, power2 = -1
+    // when the 128 bit product cannot decide the rounding
+    template<typename T>
+    [[nodiscard]] static adjusted_mantissa eisel_lemire(std::int64_t q, std::uint64_t w) {
+        using format = binary_format<T>;
+        if (w == 0 || q < format::smallest_power_of_ten)
+            return { 0, 0 };
+        if (q > format::largest_power_of_ten)
+            return { 0, format::infinite_power };
+
+        const int lz = leading_zeros(w);
+        w <<= lz;
+        const value128 product = compute_product_approximation<format::mantissa_bits + 3>(q, w);
+        // the product is exact for these powers, or good enough below
+        if (product.low == UINT64_MAX && !(q >= -27 && q <= 55))
+            return { 0, -1 };
+
+        const int upperbit = (int)(product.high >> 63);
+        const int drop = upperbit + 64 - format::mantissa_bits - 3;
+        adjusted_mantissa answer;
+        answer.mantissa = product.high >> drop;
+        // floor(log2(10^q)) + 63 is ((217706 * q) >> 16) + 63
+        answer.power2 = (int)((((152170 + 65536) * q) >> 16) + 63 + upperbit - lz - format::minimum_exponent);
+        if (answer.power2 <= 0)
         {
-            return false;
+            // subnormal, or zero when it is 64 bits below the smallest
+            if (-answer.power2 + 1 >= 64)
+                return { 0, 0 };
+            answer.mantissa >>= -answer.power2 + 1;
+            answer.mantissa += (answer.mantissa & 1);
+            answer.mantissa >>= 1;
+            // rounding up can make it the smallest normal
+            answer.power2 = (answer.mantissa < (std::uint64_t(1) << format::mantissa_bits)) ? 0 : 1;
+            return answer;
+        }
+        // round half to even when only zeros were dropped
+        if (product.low <= 1 && q >= format::min_round_to_even && q <= format::max_round_to_even
+            && (answer.mantissa & 3) == 1 && (answer.mantissa << drop) == product.high)
+            answer.mantissa &= ~std::uint64_t(1);
+
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        if (answer.mantissa >= (std::uint64_t(2) << format::mantissa_bits))
+        {
+            answer.mantissa = std::uint64_t(1) << format::mantissa_bits;
+            answer.power2++;
+        }
+        answer.mantissa &= ~(std::uint64_t(1) << format::mantissa_bits);
+        if (answer.power2 >= format::infinite_power)
+            return { 0, format::infinite_power };
+        return answer;
+    }
+    // arbitrary precision decimal 0.d[0]d[1]... * 10^decimal_point, the
+    // exact fallback. 800 digits decide the rounding of any double, a
+    // digit cut off beyond them is remembered in truncated.
+    struct big_decimal
+    {
+        static constexpr int max_digits = 800;
+        static constexpr int max_shift = 60;
+        int num_digits = 0;
+        int decimal_point = 0;
+        bool truncated = false;
+        std::uint8_t digits[max_digits];
+
+        template<typename CharT>
+        explicit big_decimal(const decimal_text<CharT>& dec) {
+            std::int64_t point = 0;
+            for (const CharT* s = dec.int_first; s != dec.int_last; ++s)
+            {
+                if ((num_digits == 0 && *s == '0') || *s == dec.group)
+                    continue;
+                push_digit((char)*s);
+                ++point;
+            }
+            for (const CharT* s = dec.frac_first; s != dec.frac_last; ++s)
+            {
+                if (num_digits == 0 && *s == '0')
+                    --point;
+                else
+                    push_digit((char)*s);
+            }
+            point += dec.exp_number;
+            decimal_point = point > 100000 ? 100000 : point < -100000 ? -100000 : (int)point;
+            trim();
+        }
+        void push_digit(char c) {
+            if (num_digits < max_digits)
+                digits[num_digits++] = (std::uint8_t)(c - '0');
+            else if (c != '0')
+                truncated = true;
+        }
+        void trim() {
+            while (num_digits > 0 && digits[num_digits - 1] == 0)
+                --num_digits;
+        }
+        // multiply by 2^shift
+        void left_shift(int shift) {
+            std::uint8_t out[max_digits + 20];
+            int n = 0;
+            std::uint64_t carry = 0;
+            for (int r = num_digits - 1; r >= 0; --r)
+            {
+                const std::uint64_t v = ((std::uint64_t)digits[r] << shift) + carry;
+                out[n++] = (std::uint8_t)(v % 10);
+                carry = v / 10;
+            }
+            for (; carry != 0; carry /= 10)
+                out[n++] = (std::uint8_t)(carry % 10);
+            decimal_point += n - num_digits;
+            num_digits = 0;
+            for (int r = n - 1; r >= 0; --r)
+                push_digit((char)('0' + out[r]));
+            trim();
+        }
+        // divide by 2^shift
+        void right_shift(int shift) {
+            int r = 0;
+            int w = 0;
+            std::uint64_t n = 0;
+            // enough leading digits for the first quotient digit
+            for (; (n >> shift) == 0; ++r)
+            {
+                if (r >= num_digits)
+                {
+                    if (n == 0)
+                    {
+                        num_digits = 0;
+                        return;
+                    }
+                    for (; (n >> shift) == 0; ++r)
+                        n *= 10;
+                    break;
+                }
+                n = n * 10 + digits[r];
+            }
+            decimal_point -= r - 1;
+            const std::uint64_t mask = (std::uint64_t(1) << shift) - 1;
+            for (; r < num_digits; ++r)
+            {
+                const std::uint8_t c = digits[r];
+                digits[w++] = (std::uint8_t)(n >> shift);
+                n = (n & mask) * 10 + c;
+            }
+            for (; n > 0; n = (n & mask) * 10)
+            {
+                const std::uint8_t d = (std::uint8_t)(n >> shift);
+                if (w < max_digits)
+                    digits[w++] = d;
+                else if (d > 0)
+                    truncated = true;
+            }
+            num_digits = w;
+            trim();
+        }
+        void shift(int k) {
+            if (num_digits == 0)
+                return;
+            for (; k > max_shift; k -= max_shift)
+                left_shift(max_shift);
+            for (; k < -max_shift; k += max_shift)
+                right_shift(max_shift);
+            if (k > 0)
+                left_shift(k);
+            else if (k < 0)
+                right_shift(-k);
+        }
+        // the integer part, rounded half to even
+        [[nodiscard]] std::uint64_t rounded_integer() const {
+            if (decimal_point > 20)
+                return UINT64_MAX;
+            std::uint64_t n = 0;
+            int i = 0;
+            for (; i < decimal_point && i < num_digits; ++i)
+                n = n * 10 + digits[i];
+            for (; i < decimal_point; ++i)
+                n *= 10;
+            if (decimal_point >= 0 && decimal_point < num_digits)
+            {
+                if (digits[decimal_point] == 5 && decimal_point + 1 == num_digits)
+                    n += truncated || (decimal_point > 0 && (digits[decimal_point - 1] & 1));
+                else
+                    n += digits[decimal_point] >= 5;
+            }
+            return n;
+        }
+    };
+    template<typename T, typename CharT>
+    [[nodiscard]] static adjusted_mantissa big_decimal_to_float(const decimal_text<CharT>& dec) {
+        using format = binary_format<T>;
+        constexpr int bias = format::minimum_exponent;
+        constexpr int max_power = (1 << format::exponent_bits) - 1;
+        // bits gained by a shift that brings decimal_point closer to zero
+        static constexpr int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+
+        big_decimal d(dec);
+        if (d.num_digits == 0 || d.decimal_point < -330)
+            return { 0, 0 };
+        if (d.decimal_point > 310)
+            return { 0, format::infinite_power };
+        // scale into [0.5, 1)
+        int exp2 = 0;
+        while (d.decimal_point > 0)
+        {
+            const int n = d.decimal_point >= 9 ? 27 : powtab[d.decimal_point];
+            d.shift(-n);
+            exp2 += n;
+        }
+        while (d.decimal_point < 0 || (d.decimal_point == 0 && d.digits[0] < 5))
+        {
+            const int n = -d.decimal_point >= 9 ? 27 : powtab[-d.decimal_point];
+            d.shift(n);
+            exp2 -= n;
+        }
+        // into [1, 2), then denormalize below the smallest exponent
+        exp2--;
+        if (exp2 < bias + 1)
+        {
+            const int n = bias + 1 - exp2;
+            d.shift(-n);
+            exp2 += n;
+        }
+        if (exp2 - bias >= max_power)
+            return { 0, format::infinite_power };
+
+        d.shift(1 + format::mantissa_bits);
+        std::uint64_t mantissa = d.rounded_integer();
+        if (mantissa == (std::uint64_t(2) << format::mantissa_bits))
+        {
+            mantissa >>= 1;
+            exp2++;
+            if (exp2 - bias >= max_power)
+                return { 0, format::infinite_power };
+        }
+        if (!(mantissa & (std::uint64_t(1) << format::mantissa_bits)))
+            exp2 = bias;
+        return { mantissa & ((std::uint64_t(1) << format::mantissa_bits) - 1), exp2 - bias };
+    }
+    // m * 2^(e - 63) with bit 63 of m set, rounded half to even, sticky
+    // for the nonzero bits below m
+    template<typename T>
+    [[nodiscard]] static adjusted_mantissa round_binary(std::uint64_t m, std::int64_t e, bool sticky) {
+        using format = binary_format<T>;
+        std::int64_t biased = e - format::minimum_exponent;
+        int shift = 63 - format::mantissa_bits;
+        if (biased < 1)
+        {
+            // under half the smallest subnormal
+            if (1 - biased > 64 - shift)
+                return { 0, 0 };
+            shift += (int)(1 - biased);
+            biased = 1;
+        }
+        const std::uint64_t kept = shift == 64 ? 0 : m >> shift;
+        const std::uint64_t half = std::uint64_t(1) << (shift - 1);
+        const std::uint64_t rem = shift == 64 ? m : m & ((half << 1) - 1);
+        const bool round_up = rem > half || (rem == half && (sticky || (kept & 1)));
+        if (biased >= format::infinite_power)
+            return { 0, format::infinite_power };
+        // a carry out of the mantissa moves into the exponent
+        const std::uint64_t bits = ((std::uint64_t)(biased - 1) << format::mantissa_bits) + kept + round_up;
+        if ((bits >> format::mantissa_bits) >= (std::uint64_t)format::infinite_power)
+            return { 0, format::infinite_power };
+        return { bits & ((std::uint64_t(1) << format::mantissa_bits) - 1), (int)(bits >> format::mantissa_bits) };
+    }
+    // pack a nonzero input, which is out of range as inf or zero
+    template<typename T>
+    [[nodiscard]] static std::errc to_float(const adjusted_mantissa& am, bool neg, T& num) {
+        using format = binary_format<T>;
+        using bits_type = typename format::bits_type;
+        if (am.power2 == format::infinite_power || (am.power2 == 0 && am.mantissa == 0))
+            return std::errc::result_out_of_range;
+        bits_type bits = (bits_type)(am.mantissa | ((std::uint64_t)am.power2 << format::mantissa_bits));
+        if (neg)
+            bits |= (bits_type)1 << (sizeof(T) * 8 - 1);
+        memcpy(&num, &bits, sizeof(num));
+        return std::errc();
+    }
+    template<typename T, typename CharT>
+    [[nodiscard]] static std::errc decimal_to_float(const decimal_text<CharT>& dec, bool neg, T& num) {
+        using format = binary_format<T>;
+        static constexpr double exact_powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        if (dec.mantissa == 0)
+        {
+            num = neg ? -T(0) : T(0);
+            return std::errc();
+        }
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+        // one rounding of two exact values is correctly rounded
+        if (!dec.truncated && dec.mantissa <= format::max_exact_mantissa
+            && dec.exponent >= -format::max_exact_power && dec.exponent <= format::max_exact_power)
+        {
+            T value = (T)dec.mantissa;
+            if (dec.exponent < 0)
+                value = value / (T)exact_powers[-dec.exponent];
+            else
+                value = value * (T)exact_powers[dec.exponent];
+            num = neg ? -value : value;
+            return std::errc();
+        }
+#endif
+        adjusted_mantissa am = eisel_lemire<T>(dec.exponent, dec.mantissa);
+        // the cut digits lie between mantissa and mantissa + 1
+        if (dec.truncated && am.power2 >= 0 && !(am == eisel_lemire<T>(dec.exponent, dec.mantissa + 1)))
+            am.power2 = -1;
+        if (am.power2 < 0)
+            am = big_decimal_to_float<T>(dec);
+        return to_float(am, neg, num);
+    }
+    template<typename CharT>
+    [[nodiscard]] static int hex_digit(CharT c) {
+        const std::uint32_t u = (std::uint32_t)(std::make_unsigned_t<CharT>)c;
+        if (u - '0' <= 9)
+            return (int)(u - '0');
+        return ((u | 0x20) - 'a' < 6) ? (int)((u | 0x20) - 'a' + 10) : -1;
+    }
+    // hex digits with an optional binary exponent, the way printf("%a")
+    // writes them without the 0x
+    template<typename CharT, typename T>
+    [[nodiscard]] static scan_result<CharT> hex_to_float(const CharT* first, const CharT* p, const CharT* last, bool neg, T& num) {
+        std::uint64_t mantissa = 0;
+        std::int64_t exponent = 0;
+        bool sticky = false;
+        bool any = false;
+        int kept = 0;
+        for (int d; p != last && (d = hex_digit(*p)) >= 0; ++p)
+        {
+            any = true;
+            if (kept < 16)
+            {
+                mantissa = mantissa * 16 + (std::uint64_t)d;
+                kept += (mantissa != 0);
+            }
+            else
+            {
+                exponent += 4;
+                sticky = sticky || d != 0;
+            }
+        }
+        if (p != last && *p == '.')
+        {
+            const CharT* q = p + 1;
+            for (int d; q != last && (d = hex_digit(*q)) >= 0; ++q)
+            {
+                any = true;
+                if (kept < 16)
+                {
+                    mantissa = mantissa * 16 + (std::uint64_t)d;
+                    kept += (mantissa != 0);
+                    exponent -= 4;
+                }
+                else
+                    sticky = sticky || d != 0;
+            }
+            if (any)
+                p = q;
+        }
+        if (!any)
+            return { first, std::errc::invalid_argument };
+        if (p != last && (*p == 'p' || *p == 'P'))
+        {
+            const CharT* q = p + 1;
+            const bool exp_neg = q != last && *q == '-';
+            if (q != last && (*q == '-' || *q == '+'))
+                ++q;
+            if (q != last && is_digit(*q))
+            {
+                std::int64_t exp_number = 0;
+                for (; q != last && is_digit(*q); ++q)
+                {
+                    if (exp_number < 0x10000000)
+                        exp_number = exp_number * 10 + (*q - '0');
+                }
+                exponent += exp_neg ? -exp_number : exp_number;
+                p = q;
+            }
+        }
+        if (mantissa == 0)
+        {
+            num = neg ? -T(0) : T(0);
+            return { p, std::errc() };
+        }
+        const int lz = leading_zeros(mantissa);
+        return { p, to_float(round_binary<T>(mantissa << lz, exponent + 63 - lz, sticky), neg, num) };
+    }
+    template<typename CharT>
+    [[nodiscard]] static bool match_word(const CharT* p, const CharT* last, const char* word) {
+        for (; *word; ++p, ++word)
+        {
+            if (p == last || ((std::uint32_t)(std::make_unsigned_t<CharT>)*p | 0x20) != (std::uint32_t)*word)
+                return false;
         }
-        for (size_t i = 0; i < len; ++i)
-            str += (char)wstr[i];
         return true;
     }
+    template<typename CharT, typename T>
+    [[nodiscard]] static scan_result<CharT> inf_nan_to_float(const CharT* first, const CharT* p, const CharT* last, bool neg, T& num) {
+        if (match_word(p, last, "inf"))
+        {
+            p += match_word(p, last, "infinity") ? 8 : 3;
+            num = neg ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+            return { p, std::errc() };
+        }
+        if (match_word(p, last, "nan"))
+        {
+            p += 3;
+            // nan(n-char-sequence)
+            if (p != last && *p == '(')
+            {
+                const CharT* q = p + 1;
+                while (q != last && (is_digit(*q) || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z') || *q == '_'))
+                    ++q;
+                if (q != last && *q == ')')
+                    p = q + 1;
+            }
+            num = neg ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+            return { p, std::errc() };
+        }
+        return { first, std::errc::invalid_argument };
+    }
+    static constexpr punctuation no_punctuation = { '\0', '.' };
+    // the float at the start of [first, last) and where it ends, with the
+    // group and decimal characters of punct in decimal text. Any
+    // character type is read in place.
+    template<typename CharT, typename T, typename Format>
+    [[nodiscard]] static scan_result<CharT> scan_float(const CharT* first, const CharT* last, T& num, Format fmt, const punctuation& punct = no_punctuation) {
+        const CharT* p = first;
+        const bool neg = p != last && *p == '-';
+        p += neg;
+        if (p == last)
+            return { first, std::errc::invalid_argument };
+        if ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')
+            return inf_nan_to_float(first, p, last, neg, num);
+        if (fmt == std::chars_format::hex)
+            return hex_to_float(first, p, last, neg, num);
 
-    // convert std::string to std::wstring
+        decimal_text<CharT> dec;
+        if (!scan_decimal(p, last, fmt, dec, punct))
+            return { first, std::errc::invalid_argument };
+        return { dec.end, decimal_to_float(dec, neg, num) };
+    }
+    // same contract as std::from_chars(first, last, num, fmt)
+    template<typename T, typename Format>
+    [[nodiscard]] static std::from_chars_result float_from_chars(const char* first, const char* last, T& num, Format fmt) {
+        const auto ret = scan_float(first, last, num, fmt);
+        return { ret.ptr, ret.ec };
+    }
+    template<typename CharT, typename T, typename Format>
+    [[nodiscard]] static bool parse_float(const CharT* first, const CharT* last, T& num, Format fmt, std::errc* ec, const punctuation& punct = no_punctuation) {
+        CONV_STAT(const stat_call stat(stat_family::str_to_float, (size_t)(last - first) * sizeof(CharT), ec);)
+        const auto ret = scan_float(first, last, num, fmt, punct);
+        if (ec) *ec = ret.ec;
+        return ret.ec == std::errc();
+    }
+public:
+    // convert string to float, the string is a std::basic_string,
+    // std::basic_string_view, C string or character array of any
+    // character type
+    //===================================
+    template<typename Str, typename T>
+    [[nodiscard]] static auto str_to_float(const Str& str, T& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr)
+        -> enable_if_float_t<T, decltype(view_of(str), bool())> {
+        const auto view = view_of(str);
+        return parse_float(view.data(), view.data() + view.size(), num, fmt, ec);
+    }
+    // convert string to float with the group and decimal characters of
+    // punct, "1.234.567,89" with { '.', ',' }. Group separators are taken
+    // in the integer part as str_to_num() takes them.
+    //===================================
+    template<typename Str, typename T>
+    [[nodiscard]] static auto str_to_float(const Str& str, T& num, const punctuation& punct, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr)
+        -> enable_if_float_t<T, decltype(view_of(str), bool())> {
+        const auto view = view_of(str);
+        return parse_float(view.data(), view.data() + view.size(), num, fmt, ec, punct);
+    }
+    // str_to_float() with the format a template argument,
+    // str_to_float<std::chars_format::fixed>(str, num)
+    //===================================
+    template<std::chars_format Fmt, typename Str, typename T>
+    [[nodiscard]] static auto str_to_float(const Str& str, T& num, std::errc* ec = nullptr)
+        -> enable_if_float_t<T, decltype(view_of(str), bool())> {
+        const auto view = view_of(str);
+        return parse_float(view.data(), view.data() + view.size(), num, format_constant<Fmt>(), ec);
+    }
+    // the families of functions that conv::stats() counts
     //===================================
-    [[nodiscard]] static bool str_to_wstr(const std::string_view& view, std::wstring& wstr) {
+    enum class stat_family { str_to_num, str_to_float, num_to_str, float_to_str };
+    static constexpr int stat_families = 4;
+private:
+#ifndef CONV_NO_ALLOC
+    // assign to str the text to_chars(buf, zeros) writes into a stack
+    // buffer of N characters and zeros '0' characters after it, widening
+    // it for wide strings
+    template<size_t N, typename CharT, typename Traits, typename Alloc, typename ToChars>
+    [[nodiscard]] static bool assign_text([[maybe_unused]] stat_family family, std::basic_string<CharT, Traits, Alloc>& str, ToChars to_chars) {
+        CONV_STAT(stat_call stat(family, std::errc::not_enough_memory);)
+        char buf[N];
+        size_t zeros = 0;
+        const std::to_chars_result ret = to_chars(buf, zeros);
+        if (ret.ec != std::errc())
+        {
+            CONV_STAT(stat.result(ret.ec, 0);)
+            return false;
+        }
+        const size_t len = (size_t)(ret.ptr - buf);
+        CONV_STAT(count_growth(str, len + zeros);)
         try {
-            wstr = std::wstring(view.cbegin(), view.cend());
+            str.reserve(len + zeros);
+            if constexpr (std::is_same_v<CharT, char>)
+                str.assign(buf, len);
+            else
+            {
+                // assign() from char iterators goes through a temporary string
+                str.clear();
+                for (size_t i = 0; i != len; ++i)
+                    str.push_back((CharT)buf[i]);
+            }
+            str.append(zeros, (CharT)'0');
         }
         catch (std::bad_alloc&)
         {
             return false;
         }
+        CONV_STAT(stat.result(std::errc(), (len + zeros) * sizeof(CharT));)
         return true;
     }
-    [[nodiscard]] static bool str_to_wstr(const std::string& str, std::wstring& wstr) {
-        try {
-            wstr = std::wstring(str.cbegin(), str.cend());
+#endif
+    // write to_chars(first, last) into the len characters at str and the
+    // terminator after it, leaving the rest of str alone. On failure str
+    // is an empty string. Other than char, the text goes through N chars
+    // on the stack, as for assign_text().
+    template<size_t N, typename CharT, typename ToChars>
+    [[nodiscard]] static bool write_text([[maybe_unused]] stat_family family, CharT* str, size_t len, ToChars to_chars) {
+        CONV_STAT(stat_call stat(family, std::errc::value_too_large);)
+        if (len == 0)
+            return false;
+        if constexpr (std::is_same_v<CharT, char>)
+        {
+            auto ret = to_chars(str, str + len - 1);
+            if (ret.ec != std::errc())
+            {
+                *str = '\0';
+                return false;
+            }
+            *ret.ptr = '\0';
+            CONV_STAT(stat.result(std::errc(), (size_t)(ret.ptr - str));)
+            return true;
         }
-        catch (std::bad_alloc&)
+        else
         {
-            return false;
+            char buf[N];
+            auto ret = to_chars(buf, buf + (len - 1 < sizeof(buf) ? len - 1 : sizeof(buf)));
+            if (ret.ec != std::errc())
+            {
+                *str = CharT();
+                return false;
+            }
+            for (const char* p = buf; p != ret.ptr; ++p)
+                *str++ = (CharT)*p;
+            *str = CharT();
+            CONV_STAT(stat.result(std::errc(), (size_t)(ret.ptr - buf) * sizeof(CharT));)
+            return true;
         }
-        return true;
     }
-    [[nodiscard]] static bool str_to_wstr(const char* str, std::wstring& wstr) {
-        std::size_t len = strlen(str);
-        try {
-            wstr = std::wstring(str, str + len);
+    // "00" to "99", so two digits take one division and one 2 byte copy
+    static constexpr char digit_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    static constexpr std::uint64_t powers_of_ten[20] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull
+    };
+    // number of decimal digits in x, 1 for 0. 1233 / 4096 is just above
+    // log10(2), so the bit length gives the count or one less than it.
+    [[nodiscard]] static constexpr int dec_digit_count(std::uint64_t x) {
+        const int t = ((64 - leading_zeros(x | 1)) * 1233) >> 12;
+        return t + ((x | 1) >= powers_of_ten[t]);
+    }
+    static void copy_pair(char* p, unsigned pair) {
+        memcpy(p, digit_pairs + pair * 2, 2);
+    }
+    // the decimal digits of x, ending at last. Above 2^32 the low 8 digits
+    // are split off first, so the rest is 32 bit arithmetic.
+    static void dec_digits(char* last, std::uint64_t x) {
+        while (x > 0xFFFFFFFFu)
+        {
+            std::uint32_t low = (std::uint32_t)(x % 100000000);
+            x /= 100000000;
+            for (int i = 0; i < 4; ++i)
+            {
+                last -= 2;
+                copy_pair(last, low % 100);
+                low /= 100;
+            }
+        }
+        std::uint32_t y = (std::uint32_t)x;
+        while (y >= 100)
+        {
+            last -= 2;
+            copy_pair(last, y % 100);
+            y /= 100;
+        }
+        if (y >= 10)
+            copy_pair(last - 2, y);
+        else
+            last[-1] = (char)('0' + y);
+    }
+    // same contract as std::to_chars(first, last, num), writing the exact
+    // length once it is known to fit
+    template<typename T>
+    [[nodiscard]] static std::to_chars_result dec_to_chars(char* first, char* last, T num) {
+        std::uint64_t magnitude = (std::uint64_t)num;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (num < 0)
+            {
+                if (first == last)
+                    return { last, std::errc::value_too_large };
+                *first++ = '-';
+                magnitude = 0 - magnitude;
+            }
+        }
+        const int n = dec_digit_count(magnitude);
+        if (last - first < n)
+            return { last, std::errc::value_too_large };
+        dec_digits(first + n, magnitude);
+        return { first + n, std::errc() };
+    }
+    // printf() text of a float in fixed notation with precision digits
+    // after the point, or in general notation with 6 digits when
+    // precision <= 0, as to_chars() writes it when given a precision.
+    // A double has at most 1074 digits after the point, so the digits
+    // past those are zeros, which are counted in zeros rather than
+    // written. -DBL_MAX then takes 1385 characters at most.
+    static constexpr int max_fraction_digits = 1074;
+
+    template<typename T>
+    [[nodiscard]] static std::to_chars_result format_float(char (&buf)[1400], T num, int precision, size_t& zeros) {
+        zeros = 0;
+        if (precision <= 0)
+            return std::to_chars(buf, buf + sizeof(buf), num, std::chars_format::general, 6);
+        if (precision > max_fraction_digits && num - num == 0)
+        {
+            zeros = (size_t)(precision - max_fraction_digits);
+            precision = max_fraction_digits;
+        }
+        return std::to_chars(buf, buf + sizeof(buf), num, std::chars_format::fixed, precision);
+    }
+    // shortest text that reads back to the same float, in the format of
+    // std::to_chars(first, last, num, fmt). The digits come from the
+    // Schubfach algorithm, which needs the powers of ten rounded up, the
+    // powers of five above with 1 added where they are truncated.
+    //===================================
+    struct decimal_fp
+    {
+        std::uint64_t digits;  // without trailing zeros
+        int exponent;          // the value is digits * 10^exponent
+    };
+    [[nodiscard]] static value128 pow10_rounded_up(int x) {
+        const int index = 2 * (x - smallest_power_of_five);
+        value128 g = { power_of_five_128[index + 1], power_of_five_128[index] };
+        if (x < -27 || x >= 0)
+        {
+            g.low++;
+            g.high += (g.low == 0);
+        }
+        return g;
+    }
+    // the high 64 bits of g * cp, with the lowest bit set when the bits
+    // below are not zero
+    [[nodiscard]] static std::uint64_t round_to_odd(const value128& g, std::uint64_t cp) {
+        const value128 x = full_multiplication(g.low, cp);
+        const value128 y = full_multiplication(g.high, cp);
+        const std::uint64_t z = y.low + x.high;
+        const std::uint64_t vb = y.high + (z < y.low);
+        return vb | (z > 1);
+    }
+    // shortest digits of the nonzero float c * 2^q, nearest the float
+    // when several are as short and the even one on a tie
+    template<typename T>
+    [[nodiscard]] static decimal_fp to_decimal(std::uint64_t fraction, int biased_exponent) {
+        using format = binary_format<T>;
+        constexpr int exponent_bias = -format::minimum_exponent + format::mantissa_bits;
+        std::uint64_t c = fraction;
+        int q = 1 - exponent_bias;
+        if (biased_exponent != 0)
+        {
+            c |= std::uint64_t(1) << format::mantissa_bits;
+            q = biased_exponent - exponent_bias;
+        }
+        decimal_fp dec;
+        if (q <= 0 && -q <= format::mantissa_bits && (c & ((std::uint64_t(1) << -q) - 1)) == 0)
+            dec = { c >> -q, 0 };  // an integer
+        else
+        {
+            const bool is_even = (c & 1) == 0;
+            const bool lower_closer = fraction == 0 && biased_exponent > 1;
+            const std::uint64_t cbl = 4 * c - 2 + lower_closer;
+            const std::uint64_t cb = 4 * c;
+            const std::uint64_t cbr = 4 * c + 2;
+            // floor(log10(2^q)), or floor(log10(3/4 * 2^q)) when the
+            // float below is closer
+            const int k = (q * 1262611 - (lower_closer ? 524031 : 0)) >> 22;
+            // 1 + q + floor(log2(10^-k))
+            const int h = q + ((-k * 1741647) >> 19) + 1;
+            const value128 g = pow10_rounded_up(-k);
+            const std::uint64_t vbl = round_to_odd(g, cbl << h);
+            const std::uint64_t vb = round_to_odd(g, cb << h);
+            const std::uint64_t vbr = round_to_odd(g, cbr << h);
+            const std::uint64_t lower = vbl + !is_even;
+            const std::uint64_t upper = vbr - !is_even;
+
+            const std::uint64_t s = vb / 4;
+            // one digit less when only one of its neighbours is inside
+            const std::uint64_t sp = s / 10;
+            const bool up_inside = lower <= 40 * sp;
+            const bool wp_inside = 40 * sp + 40 <= upper;
+            const bool u_inside = lower <= 4 * s;
+            const bool w_inside = 4 * s + 4 <= upper;
+            const std::uint64_t mid = 4 * s + 2;
+            if (s >= 10 && up_inside != wp_inside)
+                dec = { sp + wp_inside, k + 1 };
+            else if (u_inside != w_inside)
+                dec = { s + w_inside, k };
+            else
+                dec = { s + (vb > mid || (vb == mid && (s & 1) != 0)), k };
+        }
+        while (dec.digits % 10 == 0)
+        {
+            dec.digits /= 10;
+            dec.exponent++;
+        }
+        return dec;
+    }
+    // decimal digits of the integer c * 2^q, q > 0, which fixed notation
+    // writes exactly. Returns the start of the digits that end at last.
+    [[nodiscard]] static char* exact_integer(std::uint64_t c, int q, char* last) {
+        // little endian 32 bit limbs of up to 1024 bits
+        std::uint32_t limbs[34] = {};
+        const int word = q / 32;
+        const int bit = q % 32;
+        const std::uint64_t low = c << bit;
+        const std::uint64_t high = bit == 0 ? 0 : c >> (64 - bit);
+        limbs[word] = (std::uint32_t)low;
+        limbs[word + 1] = (std::uint32_t)(low >> 32);
+        limbs[word + 2] = (std::uint32_t)high;
+        int used = word + 3;
+        char* p = last;
+        while (used > 0)
+        {
+            // divide by 10^9 for the next 9 digits
+            std::uint64_t rem = 0;
+            for (int i = used - 1; i >= 0; --i)
+            {
+                const std::uint64_t cur = (rem << 32) | limbs[i];
+                limbs[i] = (std::uint32_t)(cur / 1000000000);
+                rem = cur % 1000000000;
+            }
+            while (used > 0 && limbs[used - 1] == 0)
+                --used;
+            for (int i = 0; i < 9 && (used > 0 || rem != 0); ++i)
+            {
+                *--p = (char)('0' + rem % 10);
+                rem /= 10;
+            }
+        }
+        return p;
+    }
+    [[nodiscard]] static char* write_exponent(char* p, char mark, int exponent, int min_digits) {
+        *p++ = mark;
+        *p++ = exponent < 0 ? '-' : '+';
+        unsigned e = exponent < 0 ? 0u - (unsigned)exponent : (unsigned)exponent;
+        char buf[8];
+        int n = 0;
+        do
+        {
+            buf[n++] = (char)('0' + e % 10);
+            e /= 10;
+        } while (e != 0 || n < min_digits);
+        while (n > 0)
+            *p++ = buf[--n];
+        return p;
+    }
+    // hex digits of the fraction after "1." or "0.", printf("%a") style
+    template<typename T>
+    [[nodiscard]] static std::to_chars_result hex_to_chars(char* first, char* last, bool neg, std::uint64_t fraction, int biased_exponent) {
+        using format = binary_format<T>;
+        constexpr int hex_digits = (format::mantissa_bits + 3) / 4;
+        std::uint64_t bits = fraction << (hex_digits * 4 - format::mantissa_bits);
+        int n = hex_digits;
+        for (; n > 0 && (bits & 0xF) == 0; --n)
+            bits >>= 4;
+        int exponent = 0;
+        if (biased_exponent != 0)
+            exponent = biased_exponent + format::minimum_exponent;
+        else if (fraction != 0)
+            exponent = 1 + format::minimum_exponent;
+        char buf[40];
+        char* p = buf;
+        *p++ = biased_exponent != 0 ? '1' : '0';
+        if (n > 0)
+        {
+            *p++ = '.';
+            p += n;
+            for (char* d = p; d != buf + 2; bits >>= 4)
+                *--d = "0123456789abcdef"[bits & 0xF];
+        }
+        p = write_exponent(p, 'p', exponent, 1);
+        return copy_chars(first, last, neg, buf, p);
+    }
+    [[nodiscard]] static std::to_chars_result copy_chars(char* first, char* last, bool neg, const char* text, const char* text_end) {
+        const size_t len = (size_t)(text_end - text) + neg;
+        if ((size_t)(last - first) < len)
+            return { last, std::errc::value_too_large };
+        if (neg)
+            *first++ = '-';
+        memcpy(first, text, (size_t)(text_end - text));
+        return { first + (text_end - text), std::errc() };
+    }
+    // same contract as std::to_chars(first, last, num, fmt)
+    template<typename T, typename Format>
+    [[nodiscard]] static std::to_chars_result float_to_chars(char* first, char* last, T num, Format fmt) {
+        using format = binary_format<T>;
+        using bits_type = typename format::bits_type;
+        bits_type bits;
+        memcpy(&bits, &num, sizeof(num));
+        const bool neg = (bits >> (sizeof(T) * 8 - 1)) != 0;
+        const std::uint64_t fraction = bits & ((bits_type(1) << format::mantissa_bits) - 1);
+        const int biased_exponent = (int)((bits >> format::mantissa_bits) & format::infinite_power);
+        if (biased_exponent == format::infinite_power)
+        {
+            const char* text = fraction == 0 ? "inf" : "nan";
+            return copy_chars(first, last, neg, text, text + 3);
+        }
+        if (fmt == std::chars_format::hex)
+            return hex_to_chars<T>(first, last, neg, fraction, biased_exponent);
+
+        decimal_fp dec = { 0, 0 };
+        if (fraction != 0 || biased_exponent != 0)
+            dec = to_decimal<T>(fraction, biased_exponent);
+        char digits[20];
+        const int n = (int)(dec_to_chars(digits, digits + sizeof(digits), dec.digits).ptr - digits);
+        // the exponent of the first digit in scientific notation
+        const int sci_exponent = n - 1 + dec.exponent;
+        const bool scientific = fmt == std::chars_format::scientific
+            || (fmt == std::chars_format::general && (sci_exponent < -4 || sci_exponent >= 6));
+        const int abs_exponent = sci_exponent < 0 ? -sci_exponent : sci_exponent;
+        size_t len = neg;
+        if (scientific)
+            len += (n > 1 ? n + 1 : 1) + 2 + (abs_exponent >= 100 ? 3 : 2);
+        else if (dec.exponent >= 0)
+        {
+            const int q = biased_exponent - (-format::minimum_exponent + format::mantissa_bits);
+            if (q > 0)
+            {
+                // past 2^53 the digits of the float itself are as short
+                // and closer than padding the shortest digits with zeros
+                char buf[400];
+                char* start = exact_integer(fraction | (std::uint64_t(1) << format::mantissa_bits), q, buf + sizeof(buf));
+                return copy_chars(first, last, neg, start, buf + sizeof(buf));
+            }
+            len += (size_t)(n + dec.exponent);
+        }
+        else if (n + dec.exponent > 0)
+            len += (size_t)n + 1;
+        else
+            len += (size_t)(2 - dec.exponent);
+        if ((size_t)(last - first) < len)
+            return { last, std::errc::value_too_large };
+
+        char* p = first;
+        if (neg)
+            *p++ = '-';
+        if (scientific)
+        {
+            *p++ = digits[0];
+            if (n > 1)
+            {
+                *p++ = '.';
+                memcpy(p, digits + 1, (size_t)n - 1);
+                p += n - 1;
+            }
+            p = write_exponent(p, 'e', sci_exponent, 2);
+        }
+        else if (dec.exponent >= 0)
+        {
+            memcpy(p, digits, (size_t)n);
+            p += n;
+            memset(p, '0', (size_t)dec.exponent);
+            p += dec.exponent;
+        }
+        else if (n + dec.exponent > 0)
+        {
+            const int int_digits = n + dec.exponent;
+            memcpy(p, digits, (size_t)int_digits);
+            p += int_digits;
+            *p++ = '.';
+            memcpy(p, digits + int_digits, (size_t)(n - int_digits));
+            p += n - int_digits;
+        }
+        else
+        {
+            *p++ = '0';
+            *p++ = '.';
+            memset(p, '0', (size_t)(-n - dec.exponent));
+            p += -n - dec.exponent;
+            memcpy(p, digits, (size_t)n);
+            p += n;
+        }
+        return { p, std::errc() };
+    }
+    // put group in front of every 3 digits of [digits, int_last) counted
+    // from the right, moving them and the rest of the text up to end to
+    // the right in place. The positions follow from the digit count.
+    [[nodiscard]] static std::to_chars_result group_digits(char* digits, char* int_last, char* end, char* last, char group) {
+        const size_t n = (size_t)(int_last - digits);
+        const size_t separators = group != '\0' && n > 3 ? (n - 1) / 3 : 0;
+        if (separators == 0)
+            return { end, std::errc() };
+        if ((size_t)(last - end) < separators)
+            return { last, std::errc::value_too_large };
+        memmove(int_last + separators, int_last, (size_t)(end - int_last));
+        for (char* src = int_last, *dst = int_last + separators; dst != src; )
+        {
+            src -= 3;
+            dst -= 3;
+            memmove(dst, src, 3);
+            *--dst = group;
+        }
+        return { end + separators, std::errc() };
+    }
+    // float_to_chars() with the group and decimal characters of punct in
+    // decimal text
+    template<typename T, typename Format>
+    [[nodiscard]] static std::to_chars_result punctuated_float_to_chars(char* first, char* last, T num, Format fmt, const punctuation& punct) {
+        const auto ret = float_to_chars(first, last, num, fmt);
+        // hex is left as printf("%a") writes it, as the parser reads it
+        if (ret.ec != std::errc() || fmt == std::chars_format::hex)
+            return ret;
+        char* const digits = first + (*first == '-');
+        char* int_last = digits;
+        while (int_last != ret.ptr && is_digit(*int_last))
+            ++int_last;
+        if (int_last != ret.ptr && *int_last == '.')
+            *int_last = punct.decimal;
+        return group_digits(digits, int_last, ret.ptr, last, punct.group);
+    }
+public:
+#ifndef CONV_NO_ALLOC
+    // convert float to std::basic_string, the shortest text that
+    // str_to_float() reads back to the same float, as std::to_chars()
+    // writes it in each format. hex has no 0x prefix.
+    //===================================
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<400>(stat_family::float_to_str, str, [num, fmt](char (&buf)[400], size_t&) {
+            return float_to_chars(buf, buf + sizeof(buf), num, fmt);
+        });
+    }
+    // convert float to std::basic_string with precision digits after the
+    // point, or with the default stream formatting when precision <= 0
+    //===================================
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, int precision)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<1400>(stat_family::float_to_str, str, [num, precision](char (&buf)[1400], size_t& zeros) {
+            return format_float(buf, num, precision, zeros);
+        });
+    }
+#endif
+    // convert float to a character array of len characters,
+    // including the terminator
+    //===================================
+    template<typename T, typename CharT>
+    [[nodiscard]] static auto float_to_str(T num, CharT* str, size_t len, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return write_text<400>(stat_family::float_to_str, str, len, [num, fmt](char* first, char* last) {
+            return float_to_chars(first, last, num, fmt);
+        });
+    }
+    // convert float to a std::basic_string or a character array with the
+    // group and decimal characters of punct, 1234567.89 is "1.234.567,89"
+    // with { '.', ',' } in fixed or general format
+    //===================================
+#ifndef CONV_NO_ALLOC
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, const punctuation& punct, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<512>(stat_family::float_to_str, str, [num, &punct, fmt](char (&buf)[512], size_t&) {
+            return punctuated_float_to_chars(buf, buf + sizeof(buf), num, fmt, punct);
+        });
+    }
+#endif
+    template<typename T, typename CharT>
+    [[nodiscard]] static auto float_to_str(T num, CharT* str, size_t len, const punctuation& punct, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return write_text<512>(stat_family::float_to_str, str, len, [num, &punct, fmt](char* first, char* last) {
+            return punctuated_float_to_chars(first, last, num, fmt, punct);
+        });
+    }
+    // float_to_str() with the format a template argument,
+    // float_to_str<std::chars_format::scientific>(num, str), compiled for
+    // that format alone
+    //===================================
+#ifndef CONV_NO_ALLOC
+    template<std::chars_format Fmt, typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<400>(stat_family::float_to_str, str, [num](char (&buf)[400], size_t&) {
+            return float_to_chars(buf, buf + sizeof(buf), num, format_constant<Fmt>());
+        });
+    }
+#endif
+    template<std::chars_format Fmt, typename T, typename CharT>
+    [[nodiscard]] static auto float_to_str(T num, CharT* str, size_t len)
+        -> enable_if_float_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return write_text<400>(stat_family::float_to_str, str, len, [num](char* first, char* last) {
+            return float_to_chars(first, last, num, format_constant<Fmt>());
+        });
+    }
+private:
+    [[nodiscard]] static bool Is0x(const std::string_view& str, int base) {
+        return (base == 16 && (str.length() > 2 && str[0] == '0' && (str[1] == 'X' || str[1] == 'x')));
+    }
+
+    // base 10 SIMD kernels, chosen at runtime
+    //===================================
+    enum class simd_level { none, sse41, avx2 };
+
+    [[nodiscard]] static simd_level detect_simd_level() {
+#if defined(CONV_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+#if defined(CONV_SIMD_AVX2)
+        const int max_leaf = info[0];
+#endif
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] & (1 << 19)) != 0;
+#if defined(CONV_SIMD_AVX2)
+        const bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        if (os_avx && max_leaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5))
+                return simd_level::avx2;
+        }
+#endif
+        return sse41 ? simd_level::sse41 : simd_level::none;
+#elif defined(CONV_SIMD_X86)
+        __builtin_cpu_init();
+#if defined(CONV_SIMD_AVX2)
+        if (__builtin_cpu_supports("avx2"))
+            return simd_level::avx2;
+#endif
+        if (__builtin_cpu_supports("sse4.1"))
+            return simd_level::sse41;
+        return simd_level::none;
+#else
+        return simd_level::none;
+#endif
+    }
+    [[nodiscard]] static simd_level get_simd_level() {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+#if defined(CONV_SIMD_X86)
+    [[nodiscard]] static unsigned count_trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+    // loading 16 bytes at (window + n) right-aligns the first n digits of a
+    // 16 byte block with pshufb, zeroing the bytes in front of them
+    static constexpr signed char dec_align_window[32] = {
+        -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    // for 8 to 15 readable bytes, two overlapping 8 byte loads are merged
+    // back into string order, and the unreadable tail is zeroed
+    static constexpr signed char dec_merge_mask[8][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, -128, -128, -128, -128, -128, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 15, -128, -128, -128, -128, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 14, 15, -128, -128, -128, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 13, 14, 15, -128, -128, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 15, -128, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 11, 12, 13, 14, 15, -128, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 10, 11, 12, 13, 14, 15, -128, -128 },
+        { 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15, -128 }
+    };
+    // scan at most 16 digits, returns the digit count and their value.
+    // At least 8 bytes must be readable from first.
+    [[nodiscard]] CONV_TARGET("sse4.1") static unsigned dec_scan_sse41(const char* first, const char* last, std::uint64_t& val) {
+        __m128i chunk;
+        if (last - first >= 16)
+            chunk = _mm_loadu_si128((const __m128i*)first);
+        else
+        {
+            chunk = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)first), _mm_loadl_epi64((const __m128i*)(last - 8)));
+            chunk = _mm_shuffle_epi8(chunk, _mm_loadu_si128((const __m128i*)dec_merge_mask[last - first - 8]));
+        }
+        chunk = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+        const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(9)), chunk);
+        const unsigned n = count_trailing_zeros(~(std::uint32_t)_mm_movemask_epi8(is_digit));
+        chunk = _mm_shuffle_epi8(chunk, _mm_loadu_si128((const __m128i*)(dec_align_window + n)));
+        // 16 x 1 digit -> 8 x 2 digits -> 4 x 4 digits -> 2 x 8 digits
+        chunk = _mm_maddubs_epi16(chunk, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+        chunk = _mm_madd_epi16(chunk, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+        chunk = _mm_packus_epi32(chunk, chunk);
+        chunk = _mm_madd_epi16(chunk, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+        val = (std::uint64_t)(std::uint32_t)_mm_cvtsi128_si32(chunk) * 100000000u
+            + (std::uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(chunk, 4));
+        return n;
+    }
+#if defined(CONV_SIMD_AVX2)
+    // scan at most 32 digits, returns the digit count and their value.
+    // At least 32 bytes must be readable from first.
+    [[nodiscard]] CONV_TARGET("avx2") static unsigned dec_scan_avx2(const char* first, std::uint64_t& val, bool& overflow) {
+        const __m256i chunk = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*)first), _mm256_set1_epi8('0'));
+        const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, _mm256_set1_epi8(9)), chunk);
+        const std::uint32_t mask = ~(std::uint32_t)_mm256_movemask_epi8(is_digit);
+        const unsigned n = mask ? count_trailing_zeros(mask) : 32;
+        // the high group holds the leading (n - 16) digits, the low group the last 16
+        const unsigned high = n > 16 ? n - 16 : 0;
+        const unsigned low = n - high;
+        const __m128i zero = _mm_set1_epi8('0');
+        __m128i hi = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)first), zero);
+        __m128i lo = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)(first + high)), zero);
+        hi = _mm_shuffle_epi8(hi, _mm_loadu_si128((const __m128i*)(dec_align_window + high)));
+        lo = _mm_shuffle_epi8(lo, _mm_loadu_si128((const __m128i*)(dec_align_window + low)));
+        __m256i digits = _mm256_inserti128_si256(_mm256_castsi128_si256(hi), lo, 1);
+        digits = _mm256_maddubs_epi16(digits, _mm256_setr_epi8(
+            10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+            10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+        digits = _mm256_madd_epi16(digits, _mm256_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1, 100, 1));
+        digits = _mm256_packus_epi32(digits, digits);
+        digits = _mm256_madd_epi16(digits, _mm256_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1, 10000, 1));
+        const std::uint64_t hi_val = (std::uint64_t)(std::uint32_t)_mm256_extract_epi32(digits, 0) * 100000000u
+            + (std::uint32_t)_mm256_extract_epi32(digits, 1);
+        const std::uint64_t lo_val = (std::uint64_t)(std::uint32_t)_mm256_extract_epi32(digits, 4) * 100000000u
+            + (std::uint32_t)_mm256_extract_epi32(digits, 5);
+        // UINT64_MAX is 1844'6744073709551615
+        overflow = hi_val > 1844 || (hi_val == 1844 && lo_val > 6744073709551615ull);
+        val = hi_val * 10000000000000000ull + lo_val;
+        return n;
+    }
+#endif
+#endif
+    // same contract as std::from_chars(first, last, num, 10)
+    template<typename T>
+    [[nodiscard]] static std::from_chars_result dec_from_chars(const char* first, const char* last, T& num) {
+#if defined(CONV_SIMD_X86)
+        const simd_level level = get_simd_level();
+        const char* p = first;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (p != last && *p == '-')
+            {
+                neg = true;
+                ++p;
+            }
+        }
+        // short numbers are not worth a vector
+        if (level == simd_level::none || last - p < 8)
+            return std::from_chars(first, last, num, 10);
+
+        std::uint64_t val = 0;
+        bool overflow = false;
+        unsigned n = 0;
+        unsigned max_n = 16;
+#if defined(CONV_SIMD_AVX2)
+        if (level == simd_level::avx2 && last - p >= 32)
+        {
+            n = dec_scan_avx2(p, val, overflow);
+            max_n = 32;
+        }
+        else
+#endif
+            n = dec_scan_sse41(p, last, val);
+        if (n == 0)
+            return { first, std::errc::invalid_argument };
+
+        const char* end = p + n;
+        if (n == max_n)
+        {
+            // the digit run continues past the vector
+            for (; end != last && (unsigned char)(*end - '0') <= 9; ++end)
+            {
+                const unsigned digit = (unsigned)(*end - '0');
+                if (overflow || val > (UINT64_MAX - digit) / 10)
+                    overflow = true;
+                else
+                    val = val * 10 + digit;
+            }
+        }
+        std::uint64_t limit = (std::uint64_t)(std::numeric_limits<T>::max)();
+        if constexpr (std::is_signed_v<T>)
+            limit += neg ? 1 : 0;
+        if (overflow || val > limit)
+            return { end, std::errc::result_out_of_range };
+
+        num = neg ? (T)(0 - val) : (T)val;
+        return { end, std::errc() };
+#else
+        return std::from_chars(first, last, num, 10);
+#endif
+    }
+    // log2 of a power of two radix from 2 to 32, 0 for other bases
+    [[nodiscard]] static constexpr int radix_shift(int base) {
+        switch (base)
+        {
+        case 2: return 1;
+        case 4: return 2;
+        case 8: return 3;
+        case 16: return 4;
+        case 32: return 5;
+        default: return 0;
+        }
+    }
+    // a base or float format fixed at compile time. The engines take
+    // these in place of an int or std::chars_format and are compiled for
+    // the one value, so the branches on it fold away.
+    template<int Base>
+    using base_constant = std::integral_constant<int, Base>;
+    template<std::chars_format Fmt>
+    using format_constant = std::integral_constant<std::chars_format, Fmt>;
+    // radix_shift() of a base, a constant for a base_constant
+    [[nodiscard]] static constexpr int shift_of(int base) {
+        return radix_shift(base);
+    }
+    template<int Base>
+    [[nodiscard]] static constexpr auto shift_of(base_constant<Base>) {
+        return base_constant<radix_shift(Base)>();
+    }
+    // value of a digit in bases up to 36, 36 for any other character
+    struct digit_table
+    {
+        unsigned char value[256];
+        constexpr digit_table() : value() {
+            for (int c = 0; c < 256; ++c)
+                value[c] = 36;
+            for (int d = 0; d < 10; ++d)
+                value['0' + d] = (unsigned char)d;
+            for (int letter = 0; letter < 26; ++letter)
+                value['a' + letter] = value['A' + letter] = (unsigned char)(10 + letter);
+        }
+    };
+    [[nodiscard]] static unsigned digit_value(char c) {
+        static constexpr digit_table table{};
+        return table.value[(unsigned char)c];
+    }
+    // same contract as std::from_chars(first, last, num, 1 << shift), the
+    // digits are shifted in and the range follows from the bit count
+    template<typename T, typename Shift>
+    [[nodiscard]] static std::from_chars_result pow2_from_chars(const char* first, const char* last, T& num, Shift shift) {
+        const char* p = first;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (p != last && *p == '-')
+            {
+                neg = true;
+                ++p;
+            }
+        }
+        const char* const digits_first = p;
+        while (p != last && *p == '0')
+            ++p;
+        const char* const significant = p;
+        const unsigned base = 1u << shift;
+        std::uint64_t value = 0;
+        for (unsigned d; p != last && (d = digit_value(*p)) < base; ++p)
+            value = (value << shift) | d;
+        if (p == digits_first)
+            return { first, std::errc::invalid_argument };
+
+        int bits = 0;
+        if (p != significant)
+        {
+            if ((size_t)(p - significant) > 64)
+                return { p, std::errc::result_out_of_range };
+            bits = (int)(p - significant - 1) * shift + 64 - leading_zeros(digit_value(*significant));
+        }
+        std::uint64_t limit = (std::uint64_t)(std::numeric_limits<T>::max)();
+        if constexpr (std::is_signed_v<T>)
+            limit += neg ? 1 : 0;
+        if (bits > 64 || value > limit)
+            return { p, std::errc::result_out_of_range };
+
+        num = neg ? (T)(0 - value) : (T)value;
+        return { p, std::errc() };
+    }
+    template<typename T, typename Base>
+    [[nodiscard]] static std::from_chars_result int_from_chars(const char* first, const char* last, T& num, Base base) {
+        if (base == 10)
+            return dec_from_chars(first, last, num);
+        const auto shift = shift_of(base);
+        if (shift != 0)
+            return pow2_from_chars(first, last, num, shift);
+        return std::from_chars(first, last, num, (int)base);
+    }
+    // digit of a code unit in the bases up to 36, 36 for anything else,
+    // without the table of digit_value() so that it is a constant expression
+    template<typename CharT>
+    [[nodiscard]] static constexpr unsigned constexpr_digit(CharT c) {
+        const std::uint32_t u = (std::uint32_t)(std::make_unsigned_t<CharT>)c;
+        if (u - '0' < 10)
+            return u - '0';
+        if ((u | 0x20) - 'a' < 26)
+            return (u | 0x20) - 'a' + 10;
+        return 36;
+    }
+    // same contract as std::from_chars(first, last, num, base) for any
+    // character type, one digit at a time so that it runs in a constant
+    // expression. first is moved past the digits. A separator other than
+    // CharT() is skipped between two digits; one anywhere else ends them.
+    template<typename CharT, typename T>
+    [[nodiscard]] static constexpr std::errc constexpr_from_chars(const CharT*& first, const CharT* last, T& num, int base, CharT separator = CharT()) {
+        if (base < 2 || base > 36)
+            return std::errc::invalid_argument;
+        const CharT* p = first;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (p != last && *p == '-')
+            {
+                neg = true;
+                ++p;
+            }
+        }
+        const std::uint64_t limit = (std::uint64_t)(std::numeric_limits<T>::max)() + (neg ? 1 : 0);
+        const CharT* const digits = p;
+        std::uint64_t value = 0;
+        bool overflow = false;
+        for (; p != last; ++p)
+        {
+            if (separator != CharT() && *p == separator)
+            {
+                if (p == digits || p + 1 == last || constexpr_digit(p[1]) >= (unsigned)base)
+                    break;
+                continue;
+            }
+            const unsigned d = constexpr_digit(*p);
+            if (d >= (unsigned)base)
+                break;
+            if (value > (limit - d) / (unsigned)base)
+                overflow = true;
+            else
+                value = value * (unsigned)base + d;
+        }
+        if (p == digits)
+            return std::errc::invalid_argument;
+        first = p;
+        if (overflow)
+            return std::errc::result_out_of_range;
+        num = neg ? (T)(0 - value) : (T)value;
+        return std::errc();
+    }
+    // parse_int() in a constant expression
+    template<typename CharT, typename T>
+    [[nodiscard]] static constexpr bool constexpr_parse_int(const CharT* first, const CharT* last, T& num, int base, std::errc* ec) {
+        if (base == 16 && last - first > 2 && first[0] == '0' && (first[1] == 'X' || first[1] == 'x'))
+            first += 2;
+        const std::errc ret = constexpr_from_chars(first, last, num, base);
+        if (ec) *ec = ret;
+        return ret == std::errc();
+    }
+    // the number at the start of [first, last) as str_to_num() reads it,
+    // and where it ends as std::from_chars() reports it
+    template<typename CharT, typename T, typename Base>
+    [[nodiscard]] static scan_result<CharT> scan_int(const CharT* first, const CharT* last, T& num, Base base) {
+        if constexpr (sizeof(CharT) != 1)
+            return wide_to_num(first, last, num, base);
+        else
+        {
+            const std::string_view str((const char*)first, (size_t)(last - first));
+            size_t offset = Is0x(str, base) ? 2 : 0;
+            auto ret = int_from_chars(str.data() + offset, str.data() + str.length(), num, base);
+            if (ret.ec == std::errc::invalid_argument)
+                return { first, ret.ec };
+            return { first + (ret.ptr - str.data()), ret.ec };
+        }
+    }
+    template<typename CharT, typename T, typename Base>
+    [[nodiscard]] static bool parse_int(const CharT* first, const CharT* last, T& num, Base base, std::errc* ec) {
+        CONV_STAT(const stat_call stat(stat_family::str_to_num, (size_t)(last - first) * sizeof(CharT), ec);)
+        const auto ret = scan_int(first, last, num, base);
+        if (ec) *ec = ret.ec;
+        return ret.ec == std::errc();
+    }
+    // scan_int() in base 10 with a group character taken after 1 to 3
+    // leading digits and before each following group of exactly 3. The
+    // leading digits go through the usual kernel, so a number without
+    // separators costs one compare more.
+    template<typename CharT, typename T>
+    [[nodiscard]] static scan_result<CharT> scan_grouped_int(const CharT* first, const CharT* last, T& num, char group) {
+        T lead = 0;
+        const auto ret = scan_int(first, last, lead, 10);
+        const CharT* const digits = first + (first != last && *first == '-');
+        const CharT sep = (CharT)(unsigned char)group;
+        const CharT* p = ret.ptr;
+        if (ret.ec != std::errc() || group == '\0' || p - digits > 3 || p == last || *p != sep)
+        {
+            if (ret.ec == std::errc())
+                num = lead;
+            return ret;
+        }
+        auto is_digit_at = [last](const CharT* q) { return q != last && constexpr_digit(*q) < 10; };
+        const bool neg = digits != first;
+        const std::uint64_t limit = (std::uint64_t)(std::numeric_limits<T>::max)() + (neg ? 1 : 0);
+        std::uint64_t value = neg ? 0 - (std::uint64_t)lead : (std::uint64_t)lead;
+        bool overflow = false;
+        for (; last - p >= 4 && p[0] == sep && is_digit_at(p + 1) && is_digit_at(p + 2) && is_digit_at(p + 3) && !is_digit_at(p + 4); p += 4)
+        {
+            const unsigned g = constexpr_digit(p[1]) * 100 + constexpr_digit(p[2]) * 10 + constexpr_digit(p[3]);
+            if (value > (limit - g) / 1000)
+                overflow = true;
+            else
+                value = value * 1000 + g;
+        }
+        if (overflow)
+            return { p, std::errc::result_out_of_range };
+        num = neg ? (T)(0 - value) : (T)value;
+        return { p, std::errc() };
+    }
+    template<typename CharT, typename T>
+    [[nodiscard]] static bool parse_grouped_int(const CharT* first, const CharT* last, T& num, char group, std::errc* ec) {
+        CONV_STAT(const stat_call stat(stat_family::str_to_num, (size_t)(last - first) * sizeof(CharT), ec);)
+        const auto ret = scan_grouped_int(first, last, num, group);
+        if (ec) *ec = ret.ec;
+        return ret.ec == std::errc();
+    }
+public:
+    // convert string to integer, the string is a std::basic_string,
+    // std::basic_string_view, C string or character array of any
+    // character type. It is constexpr but for a std::basic_string.
+    //===================================
+    template<typename Str, typename T>
+    [[nodiscard]] static constexpr auto str_to_num(const Str& str, T& num, int base = 10, std::errc* ec = nullptr)
+        -> enable_if_int_t<T, decltype(view_of(str), bool())> {
+        const auto view = view_of(str);
+        if (CONV_CONSTANT_EVALUATED())
+            return constexpr_parse_int(view.data(), view.data() + view.size(), num, base, ec);
+        return parse_int(view.data(), view.data() + view.size(), num, base, ec);
+    }
+    // str_to_num() with the base a template argument, str_to_num<16>(str,
+    // num), compiled for that base alone
+    //===================================
+    template<int Base, typename Str, typename T>
+    [[nodiscard]] static constexpr auto str_to_num(const Str& str, T& num, std::errc* ec = nullptr)
+        -> enable_if_int_t<T, decltype(view_of(str), bool())> {
+        static_assert(Base >= 2 && Base <= 36, "the base is 2 to 36");
+        const auto view = view_of(str);
+        if (CONV_CONSTANT_EVALUATED())
+            return constexpr_parse_int(view.data(), view.data() + view.size(), num, Base, ec);
+        return parse_int(view.data(), view.data() + view.size(), num, base_constant<Base>(), ec);
+    }
+    // convert string to integer in base 10 with the group character of
+    // punct, "1,234,567", or "1.234.567" with { '.', ',' }. A separator
+    // is taken only after 1 to 3 leading digits and before a group of
+    // exactly 3, parsing stops in front of any other.
+    //===================================
+    template<typename Str, typename T>
+    [[nodiscard]] static auto str_to_num(const Str& str, T& num, const punctuation& punct, std::errc* ec = nullptr)
+        -> enable_if_int_t<T, decltype(view_of(str), bool())> {
+        const auto view = view_of(str);
+        return parse_grouped_int(view.data(), view.data() + view.size(), num, punct.group, ec);
+    }
+    // what parse() read: the value, where its text ends in the string and
+    // the error. On failure value is 0 and end is the start of the string,
+    // or past the digits of a number out of range, as std::from_chars()
+    // reports it.
+    //===================================
+    template<typename T, typename CharT = char>
+    struct parse_result
+    {
+        T value;
+        const CharT* end;
+        std::errc ec;
+
+        [[nodiscard]] constexpr bool has_value() const {
+            return ec == std::errc();
+        }
+        constexpr explicit operator bool() const {
+            return has_value();
+        }
+        [[nodiscard]] constexpr std::errc error() const {
+            return ec;
+        }
+#ifdef __cpp_lib_expected
+        constexpr operator std::expected<T, std::errc>() const {
+            if (has_value())
+                return value;
+            return std::unexpected(ec);
+        }
+#endif
+    };
+    // parse the number at the start of str and return where it ends, for
+    // a tokenizer to carry on from there without a second pass. It reads
+    // what str_to_num() reads, 0x included, and stops at the first code
+    // unit that is not part of the number where str_to_num() would ignore
+    // the rest. end points into str.
+    //===================================
+    template<typename T, typename Str>
+    [[nodiscard]] static auto parse(const Str& str, int base = 10)
+        -> enable_if_int_t<T, parse_result<T, typename view_t<Str>::value_type>> {
+        using CharT = typename view_t<Str>::value_type;
+        const auto view = view_of(str);
+        parse_result<T, CharT> result = { T(), view.data(), std::errc() };
+        CONV_STAT(stat_call stat(stat_family::str_to_num, std::errc());)
+        const auto ret = scan_int(view.data(), view.data() + view.size(), result.value, base);
+        result.end = ret.ptr;
+        result.ec = ret.ec;
+        if (ret.ec != std::errc())
+            result.value = T();
+        CONV_STAT(stat.result(ret.ec, (size_t)(ret.ptr - view.data()) * sizeof(CharT));)
+        return result;
+    }
+    // parse the float at the start of str
+    //===================================
+    template<typename T, typename Str>
+    [[nodiscard]] static auto parse(const Str& str, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, parse_result<T, typename view_t<Str>::value_type>> {
+        using CharT = typename view_t<Str>::value_type;
+        const auto view = view_of(str);
+        parse_result<T, CharT> result = { T(), view.data(), std::errc() };
+        CONV_STAT(stat_call stat(stat_family::str_to_float, std::errc());)
+        const auto ret = scan_float(view.data(), view.data() + view.size(), result.value, fmt);
+        result.end = ret.ptr;
+        result.ec = ret.ec;
+        if (ret.ec != std::errc())
+            result.value = T();
+        CONV_STAT(stat.result(ret.ec, (size_t)(ret.ptr - view.data()) * sizeof(CharT));)
+        return result;
+    }
+    // value of the text of a C++ integer literal: decimal, 0x hex, 0b
+    // binary or 0 octal, with ' separators and an optional '-'. Text that
+    // is not such a literal throws std::invalid_argument, and a value out
+    // of the range of T throws std::out_of_range, which fails to compile
+    // in a constant expression. conv_literals uses it. With CONV_NO_ALLOC
+    // it calls std::abort() instead of throwing.
+    //===================================
+    template<typename T>
+    [[nodiscard]] static constexpr auto from_literal(const char* first, const char* last)
+        -> enable_if_int_t<T, T> {
+        const bool neg = first != last && *first == '-';
+        const char* p = first + neg;
+        int base = 10;
+        if (last - p > 1 && p[0] == '0')
+        {
+            const char x = (char)(p[1] | 0x20);
+            base = x == 'x' ? 16 : x == 'b' ? 2 : 8;
+            // the leading 0 of an octal literal is a digit, so "0'7" is 7
+            p += base == 8 ? 0 : 2;
+        }
+        std::uint64_t magnitude = 0;
+        const std::errc ec = constexpr_from_chars(p, last, magnitude, base, '\'');
+        if (ec == std::errc::result_out_of_range)
+            literal_error(true);
+        if (ec != std::errc() || p != last || (neg && !std::is_signed_v<T>))
+            literal_error(false);
+        if (magnitude > (std::uint64_t)(std::numeric_limits<T>::max)() + (neg ? 1 : 0))
+            literal_error(true);
+        return neg ? (T)(0 - magnitude) : (T)magnitude;
+    }
+private:
+    [[noreturn]] static void literal_error(bool out_of_range) {
+#ifdef CONV_NO_ALLOC
+        (void)out_of_range;
+        std::abort();
+#else
+        if (out_of_range)
+            throw std::out_of_range("conv literal out of range");
+        throw std::invalid_argument("conv literal is not an integer");
+#endif
+    }
+    template<typename T, typename Parse>
+    [[nodiscard]] static size_t batch_parse(const std::string_view* strs, T* nums, size_t count, std::errc* ecs, Parse parse) {
+        size_t failures = 0;
+        if (ecs)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const std::errc ec = parse(strs[i], nums[i]).ec;
+                ecs[i] = ec;
+                failures += (ec != std::errc());
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+                failures += (parse(strs[i], nums[i]).ec != std::errc());
+        }
+        return failures;
+    }
+    template<typename T>
+    [[nodiscard]] static size_t int_batch(const std::string_view* strs, T* nums, size_t count, int base, std::errc* ecs) {
+        if (base == 10)
+            return batch_parse(strs, nums, count, ecs, [](const std::string_view& str, T& num) {
+                return dec_from_chars(str.data(), str.data() + str.length(), num);
+            });
+        if (base == 16)
+            return batch_parse(strs, nums, count, ecs, [](const std::string_view& str, T& num) {
+                size_t offset = Is0x(str, 16) ? 2 : 0;
+                return pow2_from_chars(str.data() + offset, str.data() + str.length(), num, 4);
+            });
+        return batch_parse(strs, nums, count, ecs, [base](const std::string_view& str, T& num) {
+            return int_from_chars(str.data(), str.data() + str.length(), num, base);
+        });
+    }
+    template<typename T>
+    [[nodiscard]] static size_t float_batch(const std::string_view* strs, T* nums, size_t count, std::chars_format fmt, std::errc* ecs) {
+        return batch_parse(strs, nums, count, ecs, [fmt](const std::string_view& str, T& num) {
+            return float_from_chars(str.data(), str.data() + str.length(), num, fmt);
+        });
+    }
+public:
+    // convert std::string_view array to number array,
+    // returns the number of failed elements
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto str_to_num_batch(const std::string_view* strs, T* nums, size_t count, int base = 10, std::errc* ecs = nullptr)
+        -> enable_if_int_t<T, size_t> {
+        return int_batch(strs, nums, count, base, ecs);
+    }
+    // convert std::string_view array to float array,
+    // returns the number of failed elements
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto str_to_float_batch(const std::string_view* strs, T* nums, size_t count, std::chars_format fmt = std::chars_format::general, std::errc* ecs = nullptr)
+        -> enable_if_float_t<T, size_t> {
+        return float_batch(strs, nums, count, fmt, ecs);
+    }
+#ifdef CONV_HAS_SPAN
+private:
+    template<typename Range>
+    using range_value_t = std::remove_pointer_t<decltype(std::data(std::declval<Range&>()))>;
+
+    [[nodiscard]] static size_t batch_count(std::span<const std::string_view> strs, size_t nums, std::span<std::errc> ecs) {
+        size_t count = strs.size() < nums ? strs.size() : nums;
+        if (!ecs.empty() && ecs.size() < count)
+            count = ecs.size();
+        return count;
+    }
+public:
+    // convert std::span of std::string_view to a contiguous range of
+    // numbers such as std::span or std::vector, converts the elements
+    // common to all the ranges given
+    //===================================
+    template<typename Nums>
+    [[nodiscard]] static auto str_to_num_batch(std::span<const std::string_view> strs, Nums&& nums, int base = 10, std::span<std::errc> ecs = {})
+        -> enable_if_int_t<range_value_t<Nums>, size_t> {
+        return int_batch(strs.data(), std::data(nums), batch_count(strs, std::size(nums), ecs), base, ecs.empty() ? nullptr : ecs.data());
+    }
+    template<typename Nums>
+    [[nodiscard]] static auto str_to_float_batch(std::span<const std::string_view> strs, Nums&& nums, std::chars_format fmt = std::chars_format::general, std::span<std::errc> ecs = {})
+        -> enable_if_float_t<range_value_t<Nums>, size_t> {
+        return float_batch(strs.data(), std::data(nums), batch_count(strs, std::size(nums), ecs), fmt, ecs.empty() ? nullptr : ecs.data());
+    }
+#endif
+    // what kind of number a whole string holds, as accepted by the parsers:
+    // integer -?[0-9]+, hex 0x[0-9a-fA-F]+ as taken by base 16, floating
+    // -?([0-9]+.?[0-9]*|.[0-9]+)([eE][+-]?[0-9]+)? or inf and nan
+    enum class num_kind { invalid, integer, hex, floating };
+
+    struct classify_result
+    {
+        num_kind kind;
+        size_t digits;  // significant digits, leading zeros dropped; 0 for inf and nan
+        bool negative;  // starts with '-'
+    };
+
+    // classify a string before parsing it. Up to 9 decimal digits always
+    // fit in int32_t and up to 18 in int64_t, 10 and 19 digits may or may
+    // not. Up to 8 and 16 hex digits fit in uint32_t and uint64_t.
+    // For floating, digits counts the mantissa, up to 15 are exact in double.
+    //===================================
+    [[nodiscard]] static classify_result classify(const std::string_view& str) {
+        const char* first = str.data();
+        const size_t n = str.size();
+        const bool negative = n != 0 && first[0] == '-';
+        const bool hex = Is0x(str, 16);
+        // integers leave on the first check, a run of digits to the end
+        const size_t skip = hex ? 2 : (size_t)negative;
+        size_t zeros = 0;
+        const size_t run = digit_run(first + skip, n - skip, hex, zeros);
+        if (run == n - skip && run != 0)
+            return { hex ? num_kind::hex : num_kind::integer, run == zeros ? 1 : run - zeros, negative };
+        if (hex)
+            return { num_kind::invalid, 0, false };
+        if (n > 64)
+            return classify_scalar(first, first + n);
+        return classify_masks(first, n, classify_chars(first, n));
+    }
+
+    // classify count strings into results, returns the number of invalid ones
+    //===================================
+    static size_t classify_batch(const std::string_view* strs, classify_result* results, size_t count) {
+        size_t invalid = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = classify(strs[i]);
+            invalid += results[i].kind == num_kind::invalid;
+        }
+        return invalid;
+    }
+#ifdef CONV_HAS_SPAN
+    static size_t classify_batch(std::span<const std::string_view> strs, std::span<classify_result> results) {
+        return classify_batch(strs.data(), results.data(), strs.size() < results.size() ? strs.size() : results.size());
+    }
+#endif
+private:
+    // length of the run of base 10 or base 16 digits at first, and of the
+    // zeros leading it
+    [[nodiscard]] static size_t digit_run_scalar(const char* first, size_t n, bool hex, size_t& zeros) {
+        size_t run = 0;
+        while (run < n && digit_value(first[run]) < (hex ? 16u : 10u))
+            ++run;
+        zeros = 0;
+        while (zeros < run && first[zeros] == '0')
+            ++zeros;
+        return run;
+    }
+#if defined(CONV_SIMD_X86)
+    [[nodiscard]] CONV_TARGET("sse2") static std::uint32_t digit_mask_sse2(__m128i chunk, bool hex, std::uint32_t& zero) {
+        const __m128i dec = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(dec, _mm_set1_epi8(9)), dec);
+        if (hex)
+        {
+            const __m128i alpha = _mm_sub_epi8(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            is_digit = _mm_or_si128(is_digit, _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha));
+        }
+        zero = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('0')));
+        return (std::uint32_t)_mm_movemask_epi8(is_digit);
+    }
+    // at least 8 bytes. Below 16 bytes, two overlapping 8 byte loads are
+    // used; above, the last 16 byte block ends at the end of the string.
+    [[nodiscard]] CONV_TARGET("sse2") static size_t digit_run_sse2(const char* first, size_t n, bool hex, size_t& zeros) {
+        std::uint32_t zero;
+        if (n < 16)
+        {
+            std::uint32_t digit = digit_mask_sse2(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)first), _mm_loadl_epi64((const __m128i*)(first + n - 8))), hex, zero);
+            digit = (digit & 0xFF) | ((digit >> 8) << (n - 8));
+            zero = (zero & 0xFF) | ((zero >> 8) << (n - 8));
+            const unsigned run = count_trailing_zeros(~digit);
+            const unsigned lead = count_trailing_zeros(~zero);
+            zeros = lead < run ? lead : run;
+            return run < n ? run : n;
+        }
+        size_t run = 0;
+        bool leading = true;
+        zeros = 0;
+        while (run < n)
+        {
+            const size_t at = run + 16 <= n ? run : n - 16;
+            const unsigned width = 16 - (unsigned)(run - at);
+            const std::uint32_t digit = digit_mask_sse2(_mm_loadu_si128((const __m128i*)(first + at)), hex, zero) >> (run - at);
+            zero >>= run - at;
+            const unsigned block = count_trailing_zeros(~digit);
+            if (leading)
+            {
+                const unsigned lead = count_trailing_zeros(~zero);
+                zeros += lead < block ? lead : block;
+                leading = lead >= width;
+            }
+            run += block;
+            if (block < width)
+                break;
+        }
+        return run;
+    }
+#endif
+    [[nodiscard]] static size_t digit_run(const char* first, size_t n, bool hex, size_t& zeros) {
+#if defined(CONV_SIMD_X86)
+        if (n >= 8)
+            return digit_run_sse2(first, n, hex, zeros);
+#endif
+        return digit_run_scalar(first, n, hex, zeros);
+    }
+    // one bit per byte of a string of at most 64 bytes
+    struct char_masks
+    {
+        std::uint64_t digit = 0;
+        std::uint64_t zero = 0;
+        std::uint64_t exp = 0;   // e and E
+        std::uint64_t dot = 0;
+        std::uint64_t minus = 0;
+        std::uint64_t plus = 0;
+    };
+
+    [[nodiscard]] static unsigned count_bits64(std::uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        mask = mask - ((mask >> 1) & 0x5555555555555555u);
+        mask = (mask & 0x3333333333333333u) + ((mask >> 2) & 0x3333333333333333u);
+        return (unsigned)((((mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Fu) * 0x0101010101010101u) >> 56);
+#else
+        return (unsigned)__builtin_popcountll(mask);
+#endif
+    }
+    [[nodiscard]] static char_masks classify_chars_scalar(const char* first, size_t n) {
+        char_masks m;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const unsigned char c = (unsigned char)first[i];
+            const unsigned char lower = c | 0x20;
+            const std::uint64_t bit = (std::uint64_t)1 << i;
+            m.digit |= (unsigned char)(c - '0') <= 9 ? bit : 0;
+            m.zero |= c == '0' ? bit : 0;
+            m.exp |= lower == 'e' ? bit : 0;
+            m.dot |= c == '.' ? bit : 0;
+            m.minus |= c == '-' ? bit : 0;
+            m.plus |= c == '+' ? bit : 0;
+        }
+        return m;
+    }
+    // or the bits of raw kept by keep into m, moved from bit from to bit to
+    static void merge_char_masks(char_masks& m, const char_masks& raw, std::uint64_t keep, unsigned from, unsigned to) {
+        m.digit |= ((raw.digit & keep) >> from) << to;
+        m.zero |= ((raw.zero & keep) >> from) << to;
+        m.exp |= ((raw.exp & keep) >> from) << to;
+        m.dot |= ((raw.dot & keep) >> from) << to;
+        m.minus |= ((raw.minus & keep) >> from) << to;
+        m.plus |= ((raw.plus & keep) >> from) << to;
+    }
+#if defined(CONV_SIMD_X86)
+    [[nodiscard]] CONV_TARGET("sse2") static char_masks char_masks_sse2(__m128i chunk) {
+        const __m128i digit = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+        const __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        char_masks m;
+        m.digit = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit));
+        m.zero = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('0')));
+        m.exp = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(lower, _mm_set1_epi8('e')));
+        m.dot = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('.')));
+        m.minus = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('-')));
+        m.plus = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('+')));
+        return m;
+    }
+    // 8 to 64 bytes. Below 16 bytes, two overlapping 8 byte loads are
+    // used; above, the last 16 byte block ends at the end of the string.
+    // Overlapping bytes set the same bits twice.
+    [[nodiscard]] CONV_TARGET("sse2") static char_masks classify_chars_sse2(const char* first, size_t n) {
+        char_masks m;
+        if (n < 16)
+        {
+            const char_masks raw = char_masks_sse2(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)first), _mm_loadl_epi64((const __m128i*)(first + n - 8))));
+            merge_char_masks(m, raw, 0xFF, 0, 0);
+            merge_char_masks(m, raw, 0xFF00, 8, (unsigned)n - 8);
+            return m;
+        }
+        for (size_t i = 0; i + 16 <= n; i += 16)
+            merge_char_masks(m, char_masks_sse2(_mm_loadu_si128((const __m128i*)(first + i))), 0xFFFF, 0, (unsigned)i);
+        if (n % 16)
+            merge_char_masks(m, char_masks_sse2(_mm_loadu_si128((const __m128i*)(first + n - 16))), 0xFFFF, 0, (unsigned)n - 16);
+        return m;
+    }
+#endif
+#if defined(CONV_SIMD_AVX2)
+    // 32 to 64 bytes
+    [[nodiscard]] CONV_TARGET("avx2") static char_masks classify_chars_avx2(const char* first, size_t n) {
+        char_masks m;
+        for (size_t i = 0; i < n; i += 32)
+        {
+            const size_t at = i + 32 <= n ? i : n - 32;
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(first + at));
+            const __m256i digit = _mm256_sub_epi8(chunk, _mm256_set1_epi8('0'));
+            const __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+            char_masks raw;
+            raw.digit = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit));
+            raw.zero = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('0')));
+            raw.exp = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('e')));
+            raw.dot = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('.')));
+            raw.minus = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('-')));
+            raw.plus = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('+')));
+            merge_char_masks(m, raw, 0xFFFFFFFFu, 0, (unsigned)at);
+        }
+        return m;
+    }
+#endif
+    [[nodiscard]] static char_masks classify_chars(const char* first, size_t n) {
+#if defined(CONV_SIMD_X86)
+#if defined(CONV_SIMD_AVX2)
+        if (n >= 32 && get_simd_level() == simd_level::avx2)
+            return classify_chars_avx2(first, n);
+#endif
+        if (n >= 8)
+            return classify_chars_sse2(first, n);
+#endif
+        return classify_chars_scalar(first, n);
+    }
+    // digits from the first nonzero one on, 1 for zero
+    [[nodiscard]] static size_t significant_digits(std::uint64_t digits, std::uint64_t nonzero) {
+        if (nonzero == 0)
+            return 1;
+        return count_bits64(digits & ~((nonzero & (0 - nonzero)) - 1));
+    }
+    // inf, infinity, nan and nan(chars) in any case, after the sign
+    [[nodiscard]] static classify_result classify_special(const char* first, const char* last, bool negative) {
+        auto match = [&first, last](const char* word) {
+            const char* p = first;
+            for (; *word; ++word, ++p)
+            {
+                if (p == last || (*p | 0x20) != *word)
+                    return false;
+            }
+            first = p;
+            return true;
+        };
+        if (match("inf"))
+            match("inity");
+        else if (!match("nan"))
+            return { num_kind::invalid, 0, false };
+        else if (first != last && *first == '(')
+        {
+            for (++first; first != last && *first != ')'; ++first)
+            {
+                if (constexpr_digit(*first) >= 36 && *first != '_')
+                    return { num_kind::invalid, 0, false };
+            }
+            if (first == last)
+                return { num_kind::invalid, 0, false };
+            ++first;
+        }
+        if (first != last)
+            return { num_kind::invalid, 0, false };
+        return { num_kind::floating, 0, negative };
+    }
+    // decimal strings of at most 64 bytes that are not plain integers
+    [[nodiscard]] static classify_result classify_masks(const char* first, size_t n, const char_masks& m) {
+        const std::uint64_t all = n == 64 ? ~(std::uint64_t)0 : ((std::uint64_t)1 << n) - 1;
+        const bool negative = (m.minus & 1) != 0;
+        const std::uint64_t exp_bit = m.exp & (0 - m.exp);
+        const std::uint64_t mantissa = (m.exp ? exp_bit - 1 : all) & ~(std::uint64_t)negative;
+        const std::uint64_t exponent = all & ~(exp_bit | (exp_bit - 1));
+        const std::uint64_t exp_sign = (exp_bit << 1) & (m.minus | m.plus);
+        const std::uint64_t dots = m.dot & mantissa;
+        const bool valid = (m.exp & (m.exp - 1)) == 0
+            && (mantissa & ~(m.digit | m.dot)) == 0 && (dots & (dots - 1)) == 0 && (mantissa & m.digit) != 0
+            && (exponent & ~(m.digit | exp_sign)) == 0 && (m.exp == 0 || (exponent & m.digit) != 0);
+        if (!valid)
+            return classify_special(first + negative, first + n, negative);
+        const num_kind kind = (m.dot | m.exp) & all ? num_kind::floating : num_kind::integer;
+        return { kind, significant_digits(mantissa & m.digit, mantissa & m.digit & ~m.zero), negative };
+    }
+    // decimal strings over 64 bytes that are not plain integers
+    [[nodiscard]] static classify_result classify_scalar(const char* first, const char* last) {
+        auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+        const bool negative = first != last && *first == '-';
+        first += negative;
+        size_t digits = 0;
+        bool any = false, dot = false;
+        const char* p = first;
+        for (; p != last; ++p)
+        {
+            if (is_digit(*p))
+            {
+                any = true;
+                digits += digits != 0 || *p != '0';
+            }
+            else if (*p == '.' && !dot)
+                dot = true;
+            else
+                break;
+        }
+        if (!any)
+            return classify_special(first, last, negative);
+        const bool exp = p != last && (*p == 'e' || *p == 'E');
+        if (exp)
+        {
+            ++p;
+            if (p != last && (*p == '+' || *p == '-'))
+                ++p;
+            const char* exp_first = p;
+            while (p != last && is_digit(*p))
+                ++p;
+            if (p == exp_first)
+                return { num_kind::invalid, 0, false };
+        }
+        if (p != last)
+            return { num_kind::invalid, 0, false };
+        return { dot || exp ? num_kind::floating : num_kind::integer, digits ? digits : 1, negative };
+    }
+public:
+    // result of parsing or writing a delimited buffer
+    //===================================
+    struct delimited_result
+    {
+        size_t count;   // number of values written to nums or to the buffer
+        size_t offset;  // offset in the buffer where parsing or writing stopped
+        std::errc ec;   // first error, std::errc() if none
+    };
+private:
+    struct delimiter_set
+    {
+        bool table[256];
+        explicit delimiter_set(const std::string_view& delims) {
+            memset(table, 0, sizeof(table));
+            for (char c : delims)
+                table[(unsigned char)c] = true;
+        }
+        [[nodiscard]] bool operator()(char c) const {
+            return table[(unsigned char)c];
+        }
+    };
+    template<typename T, typename Parse>
+    [[nodiscard]] static delimited_result parse_delimited(const std::string_view& buf, const std::string_view& delims, T* nums, size_t capacity, Parse parse) {
+        const delimiter_set is_delim(delims);
+        const char* const first = buf.data();
+        const char* const last = first + buf.size();
+        const char* p = first;
+        size_t count = 0;
+        while (p != last && is_delim(*p))
+            ++p;
+        while (p != last && count < capacity)
+        {
+            T num;
+            auto ret = parse(p, last, num);
+            if (ret.ec == std::errc() && ret.ptr != last && !is_delim(*ret.ptr))
+                ret.ec = std::errc::invalid_argument;
+            if (ret.ec != std::errc())
+                return { count, (size_t)(p - first), ret.ec };
+
+            nums[count++] = num;
+            p = ret.ptr;
+            while (p != last && is_delim(*p))
+                ++p;
+        }
+        return { count, (size_t)(p - first), std::errc() };
+    }
+    template<typename T>
+    [[nodiscard]] static delimited_result int_delimited(const std::string_view& buf, const std::string_view& delims, T* nums, size_t capacity, int base) {
+        if (base == 10)
+            return parse_delimited(buf, delims, nums, capacity, [](const char* first, const char* last, T& num) {
+                return dec_from_chars(first, last, num);
+            });
+        return parse_delimited(buf, delims, nums, capacity, [base](const char* first, const char* last, T& num) {
+            if (base == 16 && last - first > 2 && first[0] == '0' && (first[1] == 'X' || first[1] == 'x'))
+                first += 2;
+            return int_from_chars(first, last, num, base);
+        });
+    }
+public:
+    // convert delimited buffer to number array in a single pass.
+    // Runs of delimiters are skipped, parsing stops at the first error
+    // or when capacity values are written.
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto str_to_num_delimited(const std::string_view& buf, const std::string_view& delims, T* nums, size_t capacity, int base = 10)
+        -> enable_if_int_t<T, delimited_result> {
+        return int_delimited(buf, delims, nums, capacity, base);
+    }
+    // convert delimited buffer to float array in a single pass
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto str_to_float_delimited(const std::string_view& buf, const std::string_view& delims, T* nums, size_t capacity, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, delimited_result> {
+        return parse_delimited(buf, delims, nums, capacity, [fmt](const char* first, const char* last, T& num) {
+            return float_from_chars(first, last, num, fmt);
+        });
+    }
+    // push-style parser for delimited integers arriving in chunks, a
+    // number split across chunks is kept as state instead of buffered
+    //===================================
+    template<typename T>
+    class incremental_parser
+    {
+        static_assert(is_int_v<T>, "incremental_parser parses integers");
+    public:
+        explicit incremental_parser(const std::string_view& delims = ",\n", int base = 10)
+            : is_delim_(delims), base_(base) {}
+
+        // parse a chunk, calling on_value(T) for every number completed in it.
+        // Returns false on the first error, which sticks until reset().
+        template<typename Callback>
+        [[nodiscard]] bool feed(const std::string_view& chunk, Callback&& on_value, std::errc* ec = nullptr) {
+            const char* p = chunk.data();
+            const char* const last = p + chunk.size();
+            if (pending_ && ec_ == std::errc())
+                p = consume(p, last, on_value);
+            while (p != last && ec_ == std::errc())
+            {
+                if (is_delim_(*p))
+                {
+                    ++p;
+                    continue;
+                }
+                // a number ending inside this chunk takes the fast path
+                const char* start = p;
+                if (base_ == 16 && last - p > 2 && p[0] == '0' && (p[1] == 'X' || p[1] == 'x'))
+                    start += 2;
+                T num;
+                auto ret = int_from_chars(start, last, num, base_);
+                if (ret.ptr != last)
+                {
+                    const bool bad = ret.ec != std::errc() || !is_delim_(*ret.ptr);
+                    if (!bad)
+                    {
+                        on_value(num);
+                        ++count_;
+                        p = ret.ptr;
+                        continue;
+                    }
+                    if (has_delim(p, last))
+                    {
+                        ec_ = ret.ec == std::errc() ? std::errc::invalid_argument : ret.ec;
+                        break;
+                    }
+                }
+                // the number may continue in the next chunk
+                pending_ = true;
+                p = consume(p, last, on_value);
+            }
+            if (ec) *ec = ec_;
+            return ec_ == std::errc();
+        }
+        // complete the number pending at the end of the stream
+        template<typename Callback>
+        [[nodiscard]] bool finish(Callback&& on_value, std::errc* ec = nullptr) {
+            if (pending_ && ec_ == std::errc())
+                end_number(on_value);
+            if (ec) *ec = ec_;
+            return ec_ == std::errc();
+        }
+        // number of values emitted so far
+        [[nodiscard]] size_t count() const {
+            return count_;
+        }
+        void reset() {
+            clear_number();
+            ec_ = std::errc();
+            count_ = 0;
+        }
+    private:
+        [[nodiscard]] bool has_delim(const char* p, const char* last) const {
+            for (; p != last; ++p)
+            {
+                if (is_delim_(*p))
+                    return true;
+            }
+            return false;
+        }
+        // consume the pending number up to the next delimiter or the chunk end
+        template<typename Callback>
+        const char* consume(const char* p, const char* last, Callback& on_value) {
+            for (; p != last; ++p)
+            {
+                const char c = *p;
+                if (is_delim_(c))
+                {
+                    end_number(on_value);
+                    return p;
+                }
+                const unsigned digit = conv::digit_value(c);
+                if (digit < (unsigned)base_)
+                {
+                    std::uint64_t limit = (std::uint64_t)(std::numeric_limits<T>::max)() + (neg_ ? 1 : 0);
+                    if (overflow_ || acc_ > (limit - digit) / (unsigned)base_)
+                        overflow_ = true;
+                    else
+                        acc_ = acc_ * (unsigned)base_ + digit;
+                    ++digits_;
+                }
+                else if (std::is_signed_v<T> && c == '-' && digits_ == 0 && !neg_ && !prefix_)
+                    neg_ = true;
+                else if (base_ == 16 && (c == 'x' || c == 'X') && digits_ == 1 && acc_ == 0 && !neg_ && !prefix_)
+                {
+                    prefix_ = true;
+                    digits_ = 0;
+                }
+                else
+                {
+                    ec_ = std::errc::invalid_argument;
+                    return last;
+                }
+            }
+            return p;
+        }
+        template<typename Callback>
+        void end_number(Callback& on_value) {
+            if (digits_ == 0)
+                ec_ = std::errc::invalid_argument;
+            else if (overflow_)
+                ec_ = std::errc::result_out_of_range;
+            else
+            {
+                on_value(neg_ ? (T)(0 - acc_) : (T)acc_);
+                ++count_;
+            }
+            clear_number();
+        }
+        void clear_number() {
+            pending_ = neg_ = prefix_ = overflow_ = false;
+            digits_ = 0;
+            acc_ = 0;
+        }
+
+        delimiter_set is_delim_;
+        int base_;
+        std::errc ec_ = std::errc();
+        size_t count_ = 0;
+        // the number in progress
+        std::uint64_t acc_ = 0;
+        unsigned digits_ = 0;
+        bool pending_ = false;
+        bool neg_ = false;
+        bool prefix_ = false;
+        bool overflow_ = false;
+    };
+private:
+    // parse a delimited buffer into a vector sized from the bytes per
+    // value of a small first block. A value takes a character and a
+    // delimiter, so a short buffer fits its first block.
+    template<typename T, typename Parse>
+    [[nodiscard]] static delimited_result parse_to_vector(const std::string_view& buf, std::vector<T>& nums, Parse& parse) {
+        size_t count = 0;
+        size_t offset = 0;
+        std::errc ec = std::errc();
+        nums.resize((std::min)(size_t(4096), buf.size() / 2 + 1));
+        while (true)
+        {
+            const delimited_result ret = parse(buf.substr(offset), nums.data() + count, nums.size() - count);
+            count += ret.count;
+            offset += ret.offset;
+            if (ret.ec != std::errc() || offset == buf.size() || count < nums.size())
+            {
+                ec = ret.ec;
+                break;
+            }
+            const size_t bytes_per_value = offset / count + 1;
+            nums.resize(count + (buf.size() - offset) / bytes_per_value * 21 / 20 + 64);
+        }
+        nums.resize(count);
+        return { count, offset, ec };
+    }
+public:
+#ifdef CONV_HAS_LOADER
+    // result of loading a numeric file
+    //===================================
+    struct load_result
+    {
+        size_t count;             // number of values loaded
+        size_t offset;            // offset in the file where parsing stopped
+        std::errc ec;             // first error, std::errc() if none
+        size_t bytes;             // file size
+        double bytes_per_second;  // throughput, including mapping the file
+    };
+private:
+    template<typename T, typename Parse>
+    [[nodiscard]] static load_result load_mapped(const char* path, std::vector<T>& nums, Parse parse) {
+        timespec start, stop;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        load_result result = { 0, 0, std::errc(), 0, 0.0 };
+        nums.clear();
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            result.ec = (std::errc)errno;
+            return result;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            result.ec = (std::errc)errno;
+            ::close(fd);
+            return result;
+        }
+        result.bytes = (size_t)st.st_size;
+        if (result.bytes > 0)
+        {
+            void* map = ::mmap(nullptr, result.bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED)
+            {
+                result.ec = (std::errc)errno;
+                ::close(fd);
+                return result;
+            }
+            ::madvise(map, result.bytes, MADV_SEQUENTIAL);
+            try {
+                const delimited_result ret = parse_to_vector(std::string_view((const char*)map, result.bytes), nums, parse);
+                result.count = ret.count;
+                result.offset = ret.offset;
+                result.ec = ret.ec;
+            }
+            catch (std::bad_alloc&)
+            {
+                result.ec = std::errc::not_enough_memory;
+            }
+            ::munmap(map, result.bytes);
+        }
+        ::close(fd);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        const double seconds = (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) * 1e-9;
+        if (seconds > 0)
+            result.bytes_per_second = (double)result.bytes / seconds;
+        return result;
+    }
+public:
+    // load a delimited numeric file through a read-only memory mapping
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto load_numbers(const char* path, std::vector<T>& nums, const std::string_view& delims = ",\n", int base = 10)
+        -> enable_if_int_t<T, load_result> {
+        return load_mapped(path, nums, [&delims, base](const std::string_view& buf, T* out, size_t capacity) {
+            return int_delimited(buf, delims, out, capacity, base);
+        });
+    }
+    template<typename T>
+    [[nodiscard]] static auto load_numbers(const char* path, std::vector<T>& nums, const std::string_view& delims = ",\n", std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, load_result> {
+        return load_mapped(path, nums, [&delims, fmt](const std::string_view& buf, T* out, size_t capacity) {
+            return str_to_float_delimited(buf, delims, out, capacity, fmt);
+        });
+    }
+#endif
+#ifdef CONV_ENABLE_PARALLEL
+private:
+    // run task(0) .. task(tasks - 1) on up to threads workers. Each worker
+    // owns a contiguous range of tasks and steals the back half of another
+    // worker's range when its own runs dry.
+    template<typename Task>
+    static void run_parallel(size_t tasks, unsigned threads, Task& task) {
+        if (threads > tasks)
+            threads = (unsigned)tasks;
+        if (threads <= 1)
+        {
+            for (size_t i = 0; i < tasks; ++i)
+                task(i);
+            return;
+        }
+        struct alignas(64) task_range
+        {
+            std::mutex lock;
+            size_t begin = 0;
+            size_t end = 0;
+        };
+        std::unique_ptr<task_range[]> ranges(new task_range[threads]);
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            ranges[t].begin = tasks * t / threads;
+            ranges[t].end = tasks * (t + 1) / threads;
+        }
+        auto worker = [&ranges, &task, threads](unsigned self) {
+            task_range& own = ranges[self];
+            while (true)
+            {
+                size_t i = 0;
+                bool found = false;
+                {
+                    std::lock_guard<std::mutex> guard(own.lock);
+                    if (own.begin < own.end)
+                    {
+                        i = own.begin++;
+                        found = true;
+                    }
+                }
+                if (found)
+                {
+                    task(i);
+                    continue;
+                }
+                size_t stolen_begin = 0;
+                size_t stolen_end = 0;
+                for (unsigned k = 1; k < threads && stolen_begin == stolen_end; ++k)
+                {
+                    task_range& victim = ranges[(self + k) % threads];
+                    std::lock_guard<std::mutex> guard(victim.lock);
+                    const size_t left = victim.end - victim.begin;
+                    if (left > 0)
+                    {
+                        stolen_end = victim.end;
+                        stolen_begin = victim.end - (left + 1) / 2;
+                        victim.end = stolen_begin;
+                    }
+                }
+                if (stolen_begin == stolen_end)
+                    return;
+
+                std::lock_guard<std::mutex> guard(own.lock);
+                own.begin = stolen_begin;
+                own.end = stolen_end;
+            }
+        };
+        std::vector<std::thread> pool;
+        try {
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t)
+                pool.emplace_back(worker, t);
+        }
+        catch (...)
+        {
+            // the workers that did start, and this thread, steal the rest
+        }
+        worker(0);
+        for (std::thread& th : pool)
+            th.join();
+    }
+    // count the runs of non-delimiters in [first, last) that start after a
+    // delimiter or at first, which is the number of values a valid block holds
+    [[nodiscard]] static size_t count_fields_scalar(const char* first, const char* last, const delimiter_set& is_delim, bool after_delim) {
+        size_t count = 0;
+        for (; first != last; ++first)
+        {
+            const bool delim = is_delim(*first);
+            count += (!delim && after_delim);
+            after_delim = delim;
+        }
+        return count;
+    }
+#if defined(CONV_SIMD_X86)
+    [[nodiscard]] static unsigned count_bits(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        mask = mask - ((mask >> 1) & 0x55555555u);
+        mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+        return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#else
+        return (unsigned)__builtin_popcount(mask);
+#endif
+    }
+    [[nodiscard]] CONV_TARGET("sse2") static size_t count_fields_sse2(const char* first, const char* last, const std::string_view& delims, const delimiter_set& is_delim) {
+        __m128i targets[8];
+        for (size_t i = 0; i < delims.size(); ++i)
+            targets[i] = _mm_set1_epi8(delims[i]);
+        size_t count = 0;
+        std::uint32_t after_delim = 1;
+        for (; last - first >= 16; first += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)first);
+            __m128i match = _mm_cmpeq_epi8(chunk, targets[0]);
+            for (size_t i = 1; i < delims.size(); ++i)
+                match = _mm_or_si128(match, _mm_cmpeq_epi8(chunk, targets[i]));
+            const std::uint32_t delim_mask = (std::uint32_t)_mm_movemask_epi8(match);
+            count += count_bits(~delim_mask & ((delim_mask << 1) | after_delim) & 0xFFFFu);
+            after_delim = delim_mask >> 15;
+        }
+        return count + count_fields_scalar(first, last, is_delim, after_delim != 0);
+    }
+#endif
+#if defined(CONV_SIMD_AVX2)
+    [[nodiscard]] CONV_TARGET("avx2,popcnt") static size_t count_fields_avx2(const char* first, const char* last, const std::string_view& delims, const delimiter_set& is_delim) {
+        __m256i targets[8];
+        for (size_t i = 0; i < delims.size(); ++i)
+            targets[i] = _mm256_set1_epi8(delims[i]);
+        size_t count = 0;
+        std::uint32_t after_delim = 1;
+        for (; last - first >= 32; first += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)first);
+            __m256i match = _mm256_cmpeq_epi8(chunk, targets[0]);
+            for (size_t i = 1; i < delims.size(); ++i)
+                match = _mm256_or_si256(match, _mm256_cmpeq_epi8(chunk, targets[i]));
+            const std::uint32_t delim_mask = (std::uint32_t)_mm256_movemask_epi8(match);
+            const std::uint32_t starts = ~delim_mask & ((delim_mask << 1) | after_delim);
+#if defined(_MSC_VER) && !defined(__clang__)
+            count += __popcnt(starts);
+#else
+            count += (size_t)__builtin_popcount(starts);
+#endif
+            after_delim = delim_mask >> 31;
+        }
+        return count + count_fields_scalar(first, last, is_delim, after_delim != 0);
+    }
+#endif
+    [[nodiscard]] static size_t count_fields(const char* first, const char* last, const std::string_view& delims, const delimiter_set& is_delim) {
+#if defined(CONV_SIMD_X86)
+        if (!delims.empty() && delims.size() <= 8)
+        {
+#if defined(CONV_SIMD_AVX2)
+            if (get_simd_level() == simd_level::avx2)
+                return count_fields_avx2(first, last, delims, is_delim);
+#endif
+            return count_fields_sse2(first, last, delims, is_delim);
+        }
+#else
+        (void)delims;
+#endif
+        return count_fields_scalar(first, last, is_delim, true);
+    }
+    template<typename T, typename Parse>
+    [[nodiscard]] static delimited_result parse_parallel(const std::string_view& buf, const std::string_view& delims, std::vector<T>& nums, unsigned threads, Parse parse) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        const size_t min_block = 256 * 1024;
+        if (threads <= 1 || buf.size() < 2 * min_block)
+            return parse_to_vector(buf, nums, parse);
+
+        // blocks start at a delimiter so that no number is split
+        const delimiter_set is_delim(delims);
+        const size_t block = (std::max)(min_block, buf.size() / ((size_t)threads * 8) + 1);
+        const size_t blocks = (buf.size() + block - 1) / block;
+        std::vector<size_t> bounds(blocks + 1);
+        bounds[0] = 0;
+        bounds[blocks] = buf.size();
+        for (size_t k = 1; k < blocks; ++k)
+        {
+            size_t pos = (std::max)(k * block, bounds[k - 1]);
+            while (pos < buf.size() && !is_delim(buf[pos]))
+                ++pos;
+            bounds[k] = pos;
+        }
+        // structural pass: values per block, then their output offsets
+        std::vector<size_t> offsets(blocks + 1);
+        auto count_task = [&](size_t k) {
+            offsets[k + 1] = count_fields(buf.data() + bounds[k], buf.data() + bounds[k + 1], delims, is_delim);
+        };
+        run_parallel(blocks, threads, count_task);
+        offsets[0] = 0;
+        for (size_t k = 0; k < blocks; ++k)
+            offsets[k + 1] += offsets[k];
+
+        nums.resize(offsets[blocks]);
+        std::vector<delimited_result> results(blocks);
+        std::atomic<size_t> first_error(blocks);
+        auto parse_task = [&](size_t k) {
+            // blocks after a failed one are never reported
+            if (k > first_error.load(std::memory_order_relaxed))
+                return;
+            results[k] = parse(buf.substr(bounds[k], bounds[k + 1] - bounds[k]), nums.data() + offsets[k], offsets[k + 1] - offsets[k]);
+            if (results[k].ec != std::errc())
+            {
+                size_t current = first_error.load();
+                while (k < current && !first_error.compare_exchange_weak(current, k))
+                    ;
+            }
+        };
+        run_parallel(blocks, threads, parse_task);
+
+        const size_t k = first_error.load();
+        if (k == blocks)
+            return { nums.size(), buf.size(), std::errc() };
+
+        nums.resize(offsets[k] + results[k].count);
+        return { nums.size(), bounds[k] + results[k].offset, results[k].ec };
+    }
+public:
+    // convert a large delimited buffer to numbers on several threads, with
+    // the same values, order and errors as str_to_num_delimited().
+    // threads = 0 uses every hardware thread.
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto str_to_num_parallel(const std::string_view& buf, const std::string_view& delims, std::vector<T>& nums, int base = 10, unsigned threads = 0)
+        -> enable_if_int_t<T, delimited_result> {
+        return parse_parallel(buf, delims, nums, threads, [&delims, base](const std::string_view& block, T* out, size_t capacity) {
+            return int_delimited(block, delims, out, capacity, base);
+        });
+    }
+    template<typename T>
+    [[nodiscard]] static auto str_to_float_parallel(const std::string_view& buf, const std::string_view& delims, std::vector<T>& nums, std::chars_format fmt = std::chars_format::general, unsigned threads = 0)
+        -> enable_if_float_t<T, delimited_result> {
+        return parse_parallel(buf, delims, nums, threads, [&delims, fmt](const std::string_view& block, T* out, size_t capacity) {
+            return str_to_float_delimited(block, delims, out, capacity, fmt);
+        });
+    }
+#endif
+public:
+    // letter case of the digits above 9 in bases over 10
+    enum class digit_case { lower, upper };
+private:
+    static constexpr char lower_digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    static constexpr char upper_digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+#if defined(CONV_SIMD_X86)
+    // all 16 hex digits of value, most significant first: the bytes are
+    // reversed, split into nibbles and looked up in digits with pshufb
+    CONV_TARGET("sse4.1") static void hex16_sse41(char (&out)[16], std::uint64_t value, const char* digits) {
+        __m128i bytes = _mm_loadl_epi64((const __m128i*)&value);
+        bytes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, -128, -128, -128, -128, -128, -128, -128, -128));
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+        const __m128i lo = _mm_and_si128(bytes, nibble);
+        const __m128i text = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)digits), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)out, text);
+    }
+#endif
+    template<int Shift>
+    static void pow2_digits(char* first, char* last, std::uint64_t value, const char* digits) {
+        do
+        {
+            *--last = digits[value & ((1u << Shift) - 1)];
+            value >>= Shift;
+        } while (last != first);
+    }
+    // value in base (1 << shift). The digit count follows from the bit
+    // length, so the digits are written once, right to left, in place.
+    template<typename Shift>
+    [[nodiscard]] static std::to_chars_result pow2_to_chars(char* first, char* last, std::uint64_t value, Shift shift, const char* digits) {
+        const int bits = 64 - leading_zeros(value | 1);
+        const size_t n = (size_t)((bits + shift - 1) / shift);
+        if ((size_t)(last - first) < n)
+            return { last, std::errc::value_too_large };
+#if defined(CONV_SIMD_X86)
+        // long hex values are cheaper as one vector than 9 to 16 lookups
+        if (shift == 4 && n > 8 && get_simd_level() != simd_level::none)
+        {
+            char text[16];
+            hex16_sse41(text, value, digits);
+            memcpy(first, text + 16 - n, n);
+            return { first + n, std::errc() };
+        }
+#endif
+        switch (shift)
+        {
+        case 1: pow2_digits<1>(first, first + n, value, digits); break;
+        case 2: pow2_digits<2>(first, first + n, value, digits); break;
+        case 3: pow2_digits<3>(first, first + n, value, digits); break;
+        case 4: pow2_digits<4>(first, first + n, value, digits); break;
+        default: pow2_digits<5>(first, first + n, value, digits); break;
+        }
+        return { first + n, std::errc() };
+    }
+    // same contract as std::to_chars(first, last, num, base), with the
+    // letters in the given case
+    template<typename T, typename Base>
+    [[nodiscard]] static std::to_chars_result int_to_chars(char* first, char* last, T num, Base base, digit_case letters) {
+        if (base == 10)
+            return dec_to_chars(first, last, num);
+        const char* digits = letters == digit_case::upper ? upper_digits : lower_digits;
+        const auto shift = shift_of(base);
+        if (shift != 0)
+        {
+            std::uint64_t magnitude = (std::uint64_t)num;
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (num < 0)
+                {
+                    if (first == last)
+                        return { last, std::errc::value_too_large };
+                    *first++ = '-';
+                    magnitude = 0 - magnitude;
+                }
+            }
+            return pow2_to_chars(first, last, magnitude, shift, digits);
+        }
+        auto ret = std::to_chars(first, last, num, (int)base);
+        if (ret.ec == std::errc() && letters == digit_case::upper)
+        {
+            for (char* p = first; p != ret.ptr; ++p)
+            {
+                if (*p >= 'a')
+                    *p = digits[*p - 'a' + 10];
+            }
+        }
+        return ret;
+    }
+    // int_to_chars() in a constant expression, writing any character type,
+    // returns nullptr when the text does not fit
+    template<typename CharT, typename T>
+    [[nodiscard]] static constexpr CharT* constexpr_to_chars(CharT* first, CharT* last, T num, int base, digit_case letters) {
+        const char* digits = letters == digit_case::upper ? upper_digits : lower_digits;
+        std::uint64_t magnitude = (std::uint64_t)num;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            neg = num < 0;
+            if (neg)
+                magnitude = 0 - magnitude;
+        }
+        char reversed[64] = {};
+        int n = 0;
+        do
+        {
+            reversed[n++] = digits[magnitude % (unsigned)base];
+            magnitude /= (unsigned)base;
+        } while (magnitude != 0);
+        if (last - first < neg + n)
+            return nullptr;
+        if (neg)
+            *first++ = '-';
+        while (n != 0)
+            *first++ = (CharT)reversed[--n];
+        return first;
+    }
+    // integer text for a std::basic_string: decimal, or a power of two base
+    // like printf("%o") and printf("%X"), which print a negative number as
+    // its two's complement at the width of int or wider
+    template<typename T, typename Base>
+    [[nodiscard]] static std::to_chars_result format_int(char (&buf)[72], T num, Base base, digit_case letters) {
+        if (base == 10)
+            return dec_to_chars(buf, buf + sizeof(buf), num);
+        const auto shift = shift_of(base);
+        if (shift == 0)
+            return { buf, std::errc::invalid_argument };
+        using promoted = std::make_unsigned_t<std::common_type_t<T, int>>;
+        return pow2_to_chars(buf, buf + sizeof(buf), (promoted)num, shift,
+            letters == digit_case::upper ? upper_digits : lower_digits);
+    }
+    // decimal text with group between every 3 digits, written from the
+    // right once the digit count gives the length
+    template<typename T>
+    [[nodiscard]] static std::to_chars_result grouped_to_chars(char* first, char* last, T num, char group) {
+        if (group == '\0')
+            return dec_to_chars(first, last, num);
+        std::uint64_t magnitude = (std::uint64_t)num;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            neg = num < 0;
+            if (neg)
+                magnitude = 0 - magnitude;
+        }
+        const int n = dec_digit_count(magnitude);
+        const std::ptrdiff_t len = neg + n + (n - 1) / 3;
+        if (last - first < len)
+            return { last, std::errc::value_too_large };
+        if (neg)
+            *first = '-';
+        char* p = first + len;
+        while (magnitude >= 1000)
+        {
+            const unsigned g = (unsigned)(magnitude % 1000);
+            magnitude /= 1000;
+            p -= 3;
+            p[0] = (char)('0' + g / 100);
+            copy_pair(p + 1, g % 100);
+            *--p = group;
+        }
+        dec_digits(p, magnitude);
+        return { first + len, std::errc() };
+    }
+public:
+#ifndef CONV_NO_ALLOC
+    // convert number to std::basic_string, base is 2, 4, 8, 10, 16 or 32,
+    // and a negative number is written as its two's complement in the
+    // power of two bases
+    //===================================
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, int base, digit_case letters)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<72>(stat_family::num_to_str, str, [num, base, letters](char (&buf)[72], size_t&) {
+            return format_int(buf, num, base, letters);
+        });
+    }
+    // hex letters are upper case
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, int base = 10)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return num_to_str(num, str, base, digit_case::upper);
+    }
+#endif
+    // convert number to a character array of len characters,
+    // including the terminator, base is 2 to 36. It is constexpr.
+    //===================================
+    template<typename T, typename CharT>
+    [[nodiscard]] static constexpr auto num_to_str(T num, CharT* str, size_t len, int base, digit_case letters)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        if (base < 2 || base > 36)
+            return false;
+        if (CONV_CONSTANT_EVALUATED())
+        {
+            if (len == 0)
+                return false;
+            CharT* const last = constexpr_to_chars(str, str + len - 1, num, base, letters);
+            *(last ? last : str) = CharT();
+            return last != nullptr;
+        }
+        return write_text<72>(stat_family::num_to_str, str, len, [num, base, letters](char* first, char* last) {
+            return int_to_chars(first, last, num, base, letters);
+        });
+    }
+    // letters are lower case, like std::to_chars()
+    template<typename T, typename CharT>
+    [[nodiscard]] static constexpr auto num_to_str(T num, CharT* str, size_t len, int base = 10)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return num_to_str(num, str, len, base, digit_case::lower);
+    }
+    // num_to_str() with the base a template argument, num_to_str<16>(num,
+    // str), compiled for that base alone. Letters are upper case for a
+    // std::basic_string and lower case for a character array by default.
+    //===================================
+#ifndef CONV_NO_ALLOC
+    template<int Base, typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, digit_case letters = digit_case::upper)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        static_assert(Base == 10 || radix_shift(Base) != 0, "the base of a std::basic_string is 2, 4, 8, 10, 16 or 32");
+        return assign_text<72>(stat_family::num_to_str, str, [num, letters](char (&buf)[72], size_t&) {
+            return format_int(buf, num, base_constant<Base>(), letters);
+        });
+    }
+#endif
+    template<int Base, typename T, typename CharT>
+    [[nodiscard]] static constexpr auto num_to_str(T num, CharT* str, size_t len, digit_case letters = digit_case::lower)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        static_assert(Base >= 2 && Base <= 36, "the base is 2 to 36");
+        if (CONV_CONSTANT_EVALUATED())
+            return num_to_str(num, str, len, Base, letters);
+        return write_text<72>(stat_family::num_to_str, str, len, [num, letters](char* first, char* last) {
+            return int_to_chars(first, last, num, base_constant<Base>(), letters);
+        });
+    }
+    // convert number to decimal text with the group character of punct,
+    // "1,234,567", or "1.234.567" with { '.', ',' }
+    //===================================
+#ifndef CONV_NO_ALLOC
+    template<typename T, typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str(T num, std::basic_string<CharT, Traits, Alloc>& str, const punctuation& punct)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return assign_text<32>(stat_family::num_to_str, str, [num, &punct](char (&buf)[32], size_t&) {
+            return grouped_to_chars(buf, buf + sizeof(buf), num, punct.group);
+        });
+    }
+#endif
+    template<typename T, typename CharT>
+    [[nodiscard]] static auto num_to_str(T num, CharT* str, size_t len, const punctuation& punct)
+        -> enable_if_int_t<T, std::enable_if_t<is_char_v<CharT>, bool>> {
+        return write_text<32>(stat_family::num_to_str, str, len, [num, &punct](char* first, char* last) {
+            return grouped_to_chars(first, last, num, punct.group);
+        });
+    }
+    // how str_to_decimal() treats the digits past the scale: cut off, or
+    // rounded to nearest with ties away from zero or to even
+    enum class rounding { truncate, half_up, half_even };
+private:
+    // [-]digits[.digits] as a 64 bit integer scaled by 10^scale. The whole
+    // and the kept fraction digits go through the str_to_num() kernel.
+    template<typename CharT>
+    [[nodiscard]] static scan_result<CharT> scan_fixed_point(const CharT* first, const CharT* last, std::int64_t& scaled, int scale, rounding mode) {
+        if (scale < 0 || scale > 18)
+            return { first, std::errc::invalid_argument };
+        auto is_digit_at = [last](const CharT* q) { return q != last && constexpr_digit(*q) < 10; };
+        // the base 10 kernel without the 0x check of scan_int()
+        auto digit_run_of = [](const CharT* f, const CharT* l, std::uint64_t& value) -> scan_result<CharT> {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                const auto ret = dec_from_chars((const char*)f, (const char*)l, value);
+                return { f + (ret.ptr - (const char*)f), ret.ec };
+            }
+            else
+                return scan_int(f, l, value, 10);
+        };
+        const CharT* p = first;
+        const bool neg = p != last && *p == '-';
+        p += neg;
+        const CharT* const int_first = p;
+        std::uint64_t int_part = 0;
+        bool overflow = false;
+        if (is_digit_at(p))
+        {
+            const auto ret = digit_run_of(p, last, int_part);
+            overflow = ret.ec == std::errc::result_out_of_range;
+            p = ret.ptr;
+        }
+        const bool any_int = p != int_first;
+        std::uint64_t fraction = 0;
+        int kept = 0;
+        unsigned next = 0;
+        bool sticky = false;
+        if (p != last && *p == '.' && (any_int || is_digit_at(p + 1)))
+        {
+            const CharT* const frac_first = ++p;
+            if (scale > 0 && is_digit_at(p))
+                p = digit_run_of(p, last - p > scale ? p + scale : last, fraction).ptr;
+            kept = (int)(p - frac_first);
+            if (is_digit_at(p))
+            {
+                next = constexpr_digit(*p);
+                for (++p; is_digit_at(p); ++p)
+                    sticky = sticky || *p != '0';
+            }
+        }
+        else if (!any_int)
+            return { first, std::errc::invalid_argument };
+
+        const std::uint64_t limit = (std::uint64_t)(std::numeric_limits<std::int64_t>::max)() + neg;
+        std::uint64_t value = 0;
+        if (overflow || int_part > limit / powers_of_ten[scale])
+            overflow = true;
+        else
+        {
+            value = int_part * powers_of_ten[scale];
+            const std::uint64_t tail = fraction * powers_of_ten[scale - kept];
+            overflow = value > limit - tail;
+            value += tail;
+        }
+        bool up = false;
+        if (mode == rounding::half_up)
+            up = next >= 5;
+        else if (mode == rounding::half_even)
+            up = next > 5 || (next == 5 && (sticky || (value & 1)));
+        if (up && !overflow)
+        {
+            overflow = value == limit;
+            ++value;
+        }
+        if (overflow)
+            return { p, std::errc::result_out_of_range };
+        scaled = neg ? (std::int64_t)(0 - value) : (std::int64_t)value;
+        return { p, std::errc() };
+    }
+    // scaled / 10^scale with exactly scale digits after the point
+    [[nodiscard]] static std::to_chars_result decimal_to_chars(char* first, char* last, std::int64_t scaled, int scale) {
+        if (scale < 0 || scale > 18)
+            return { first, std::errc::invalid_argument };
+        const bool neg = scaled < 0;
+        const std::uint64_t magnitude = neg ? 0 - (std::uint64_t)scaled : (std::uint64_t)scaled;
+        const std::uint64_t whole = magnitude / powers_of_ten[scale];
+        const std::uint64_t fraction = magnitude % powers_of_ten[scale];
+        const int n = dec_digit_count(whole);
+        const std::ptrdiff_t len = neg + n + (scale > 0 ? 1 + scale : 0);
+        if (last - first < len)
+            return { last, std::errc::value_too_large };
+        char* p = first;
+        if (neg)
+            *p++ = '-';
+        dec_digits(p + n, whole);
+        p += n;
+        if (scale > 0)
+        {
+            *p++ = '.';
+            memset(p, '0', (size_t)scale);
+            if (fraction != 0)
+                dec_digits(p + scale, fraction);
+        }
+        return { first + len, std::errc() };
+    }
+public:
+    // convert decimal text to an integer scaled by 10^scale without a
+    // float, "123.4500" is 1234500 with scale 4 or 12345 with scale 2.
+    // The text is an optional '-', digits and an optional '.' with more
+    // digits, any string kind; parsing stops at anything else, an
+    // exponent included. Digits past scale are rounded by mode. scale is
+    // 0 to 18, a result beyond int64_t fails with result_out_of_range.
+    //===================================
+    template<typename Str>
+    [[nodiscard]] static auto str_to_decimal(const Str& str, std::int64_t& scaled, int scale, rounding mode = rounding::half_even, std::errc* ec = nullptr)
+        -> decltype(view_of(str), bool()) {
+        const auto view = view_of(str);
+        CONV_STAT(const stat_call stat(stat_family::str_to_num, view.size() * sizeof(view[0]), ec);)
+        const auto ret = scan_fixed_point(view.data(), view.data() + view.size(), scaled, scale, mode);
+        if (ec) *ec = ret.ec;
+        return ret.ec == std::errc();
+    }
+    // convert an integer scaled by 10^scale to decimal text with scale
+    // digits after the point, 1234500 with scale 4 is "123.4500". scale
+    // is 0 to 18, 0 writes no point.
+    //===================================
+#ifndef CONV_NO_ALLOC
+    template<typename CharT, typename Traits, typename Alloc>
+    [[nodiscard]] static auto decimal_to_str(std::int64_t scaled, int scale, std::basic_string<CharT, Traits, Alloc>& str)
+        -> std::enable_if_t<is_char_v<CharT>, bool> {
+        return assign_text<48>(stat_family::num_to_str, str, [scaled, scale](char (&buf)[48], size_t&) {
+            return decimal_to_chars(buf, buf + sizeof(buf), scaled, scale);
+        });
+    }
+#endif
+    template<typename CharT>
+    [[nodiscard]] static auto decimal_to_str(std::int64_t scaled, int scale, CharT* str, size_t len)
+        -> std::enable_if_t<is_char_v<CharT>, bool> {
+        return write_text<48>(stat_family::num_to_str, str, len, [scaled, scale](char* first, char* last) {
+            return decimal_to_chars(first, last, scaled, scale);
+        });
+    }
+private:
+    // text of nums[i] to nums[count - 1] from p in [first, last), with
+    // delim between the values, resuming after the i values before p.
+    // On failure count is the values written and offset where the failed
+    // one would start, its delimiter included, so it can be resumed there.
+    template<typename T, typename ToChars>
+    [[nodiscard]] static delimited_result batch_to_chars(const T* nums, size_t i, size_t count, char delim, char* first, char* p, char* last, size_t* offsets, ToChars to_chars) {
+        for (; i < count; ++i)
+        {
+            char* const start = p;
+            if (i != 0)
+            {
+                if (p == last)
+                    return { i, (size_t)(start - first), std::errc::value_too_large };
+                *p++ = delim;
+            }
+            auto ret = to_chars(p, last, nums[i]);
+            if (ret.ec != std::errc())
+                return { i, (size_t)(start - first), ret.ec };
+            if (offsets)
+                offsets[i] = (size_t)(p - first);
+            p = ret.ptr;
+        }
+        return { count, (size_t)(p - first), std::errc() };
+    }
+    // base 10 goes four values at a time while the longest four surely
+    // fit: the digit counts are independent of each other, then the
+    // digits are written without bound checks
+    template<typename T>
+    [[nodiscard]] static delimited_result int_batch_to_chars(const T* nums, size_t i, size_t count, char delim, char* first, char* p, char* last, size_t* offsets, int base) {
+        if (base == 10)
+        {
+            // sign, digits and delimiter
+            constexpr size_t max_len = std::numeric_limits<T>::digits10 + 3;
+            for (; count - i >= 4 && (size_t)(last - p) >= 4 * max_len; i += 4)
+            {
+                std::uint64_t magnitude[4];
+                bool neg[4];
+                int n[4];
+                for (int j = 0; j < 4; ++j)
+                {
+                    const T num = nums[i + j];
+                    neg[j] = num < 0;
+                    magnitude[j] = neg[j] ? 0 - (std::uint64_t)num : (std::uint64_t)num;
+                    n[j] = dec_digit_count(magnitude[j]);
+                }
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (i + j != 0)
+                        *p++ = delim;
+                    if (offsets)
+                        offsets[i + j] = (size_t)(p - first);
+                    *p = '-';
+                    p += neg[j];
+                    dec_digits(p + n[j], magnitude[j]);
+                    p += n[j];
+                }
+            }
+        }
+        return batch_to_chars(nums, i, count, delim, first, p, last, offsets, [base](char* begin, char* end, T num) {
+            return int_to_chars(begin, end, num, base, digit_case::lower);
+        });
+    }
+    // characters of num in base
+    template<typename T>
+    [[nodiscard]] static size_t int_text_length(T num, int base) {
+        const bool neg = num < 0;
+        std::uint64_t magnitude = neg ? 0 - (std::uint64_t)num : (std::uint64_t)num;
+        if (base == 10)
+            return neg + (size_t)dec_digit_count(magnitude);
+        if (const int shift = radix_shift(base))
+            return neg + (size_t)((64 - leading_zeros(magnitude | 1) + shift - 1) / shift);
+        size_t n = 1;
+        for (; magnitude >= (std::uint64_t)base; magnitude /= (std::uint64_t)base)
+            ++n;
+        return neg + n;
+    }
+    template<typename T>
+    [[nodiscard]] static size_t int_batch_length(const T* nums, size_t count, int base) {
+        size_t len = count != 0 ? count - 1 : 0;
+        for (size_t i = 0; i < count; ++i)
+            len += int_text_length(nums[i], base);
+        return len;
+    }
+#ifndef CONV_NO_ALLOC
+    // fill str from write(first, p, last, done), starting at size_hint
+    // characters and growing when a value does not fit
+    template<typename Traits, typename Alloc, typename Write>
+    [[nodiscard]] static bool batch_to_string(std::basic_string<char, Traits, Alloc>& str, size_t size_hint, Write write) {
+        try {
+            str.resize(size_hint);
+            size_t done = 0;
+            size_t pos = 0;
+            while (true)
+            {
+                const delimited_result ret = write(str.data(), str.data() + pos, str.data() + str.size(), done);
+                if (ret.ec != std::errc::value_too_large)
+                {
+                    str.resize(ret.ec == std::errc() ? ret.offset : 0);
+                    return ret.ec == std::errc();
+                }
+                done = ret.count;
+                pos = ret.offset;
+                str.resize(str.size() * 2 + 400);
+            }
         }
         catch (std::bad_alloc&)
         {
             return false;
         }
-        return true;
     }
+    // the text of a float is rarely longer than this outside fixed notation
+    [[nodiscard]] static size_t float_length_hint(std::chars_format fmt) {
+        return fmt == std::chars_format::fixed ? 32 : 25;
+    }
+#endif
 public:
-    // convert std::string_view to float
+    // convert number array to one buffer of len characters with delim
+    // between the values and a terminator after them, as num_to_str()
+    // writes them to a character array. offsets, if given, receives where
+    // each value starts. On failure the values that fit are kept.
     //===================================
-    [[nodiscard]] static bool str_to_float(const std::string_view& str, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        auto ret = std::from_chars(str.data(), str.data() + str.length(), num, fmt);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
-    }
-    [[nodiscard]] static bool str_to_float(const std::string_view& str, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        auto ret = std::from_chars(str.data(), str.data() + str.length(), num, fmt);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    template<typename T>
+    [[nodiscard]] static auto num_to_str_batch(const T* nums, size_t count, char delim, char* str, size_t len, int base = 10, size_t* offsets = nullptr)
+        -> enable_if_int_t<T, delimited_result> {
+        if (len == 0)
+            return { 0, 0, std::errc::value_too_large };
+        delimited_result ret = { 0, 0, std::errc::invalid_argument };
+        if (base >= 2 && base <= 36)
+            ret = int_batch_to_chars(nums, 0, count, delim, str, str, str + len - 1, offsets, base);
+        str[ret.offset] = '\0';
+        return ret;
     }
-    // convert std::string to float
+#ifndef CONV_NO_ALLOC
+    // convert number array to a std::string with delim between the values,
+    // sized once from the digit counts
     //===================================
-    [[nodiscard]] static bool str_to_float(const std::string& str, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
-    }
-    [[nodiscard]] static bool str_to_float(const std::string& str, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+    template<typename T, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str_batch(const T* nums, size_t count, char delim, std::basic_string<char, Traits, Alloc>& str, int base = 10, size_t* offsets = nullptr)
+        -> enable_if_int_t<T, bool> {
+        if (base < 2 || base > 36)
+            return false;
+        return batch_to_string(str, int_batch_length(nums, count, base), [=](char* first, char* p, char* last, size_t done) {
+            return int_batch_to_chars(nums, done, count, delim, first, p, last, offsets, base);
+        });
     }
-    // convert const char* to float
+#endif
+    // convert float array to one buffer of len characters with delim
+    // between the values, as float_to_str() writes them
     //===================================
-    [[nodiscard]] static bool str_to_float(const char* str, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        return str_to_float(std::string_view(str), num, fmt, ec);
+    template<typename T>
+    [[nodiscard]] static auto float_to_str_batch(const T* nums, size_t count, char delim, char* str, size_t len, std::chars_format fmt = std::chars_format::general, size_t* offsets = nullptr)
+        -> enable_if_float_t<T, delimited_result> {
+        if (len == 0)
+            return { 0, 0, std::errc::value_too_large };
+        const delimited_result ret = batch_to_chars(nums, 0, count, delim, str, str, str + len - 1, offsets, [fmt](char* first, char* last, T num) {
+            return float_to_chars(first, last, num, fmt);
+        });
+        str[ret.offset] = '\0';
+        return ret;
     }
-    [[nodiscard]] static bool str_to_float(const char* str, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        return str_to_float(std::string_view(str), num, fmt, ec);
-    }
-    // convert std::wstring_view to float
-    //===================================
-    [[nodiscard]] static bool str_to_float(const std::wstring_view& wstr, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+#ifndef CONV_NO_ALLOC
+    template<typename T, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str_batch(const T* nums, size_t count, char delim, std::basic_string<char, Traits, Alloc>& str, std::chars_format fmt = std::chars_format::general, size_t* offsets = nullptr)
+        -> enable_if_float_t<T, bool> {
+        return batch_to_string(str, count * float_length_hint(fmt), [=](char* first, char* p, char* last, size_t done) {
+            return batch_to_chars(nums, done, count, delim, first, p, last, offsets, [fmt](char* begin, char* end, T num) {
+                return float_to_chars(begin, end, num, fmt);
+            });
+        });
     }
-    [[nodiscard]] static bool str_to_float(const std::wstring_view& wstr, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+#endif
+#ifdef CONV_HAS_SPAN
+private:
+    template<typename Range>
+    using number_of_t = std::remove_const_t<range_value_t<Range>>;
 
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+    [[nodiscard]] static size_t* batch_offsets(size_t count, std::span<size_t> offsets) {
+        return offsets.size() < count ? nullptr : offsets.data();
     }
-    // convert std::wstring to float
+public:
+    // convert a contiguous range of numbers such as std::span or
+    // std::vector to a std::span of characters or a std::string.
+    // offsets is used when it has room for every value.
     //===================================
-    [[nodiscard]] static bool str_to_float(const std::wstring& wstr, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+    template<typename Nums>
+    [[nodiscard]] static auto num_to_str_batch(const Nums& nums, char delim, std::span<char> str, int base = 10, std::span<size_t> offsets = {})
+        -> enable_if_int_t<number_of_t<const Nums>, delimited_result> {
+        return num_to_str_batch(std::data(nums), std::size(nums), delim, str.data(), str.size(), base, batch_offsets(std::size(nums), offsets));
     }
-    [[nodiscard]] static bool str_to_float(const std::wstring& wstr, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+#ifndef CONV_NO_ALLOC
+    template<typename Nums, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str_batch(const Nums& nums, char delim, std::basic_string<char, Traits, Alloc>& str, int base = 10, std::span<size_t> offsets = {})
+        -> enable_if_int_t<number_of_t<const Nums>, bool> {
+        return num_to_str_batch(std::data(nums), std::size(nums), delim, str, base, batch_offsets(std::size(nums), offsets));
     }
-    // convert const wchar_t* to float
-    //===================================
-    [[nodiscard]] static bool str_to_float(const wchar_t* wstr, float& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+#endif
+    template<typename Nums>
+    [[nodiscard]] static auto float_to_str_batch(const Nums& nums, char delim, std::span<char> str, std::chars_format fmt = std::chars_format::general, std::span<size_t> offsets = {})
+        -> enable_if_float_t<number_of_t<const Nums>, delimited_result> {
+        return float_to_str_batch(std::data(nums), std::size(nums), delim, str.data(), str.size(), fmt, batch_offsets(std::size(nums), offsets));
     }
-    [[nodiscard]] static bool str_to_float(const wchar_t* wstr, double& num, std::chars_format fmt = std::chars_format::general, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_float(std::string_view(str.c_str(), str.size()), num, fmt, ec);
+#ifndef CONV_NO_ALLOC
+    template<typename Nums, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str_batch(const Nums& nums, char delim, std::basic_string<char, Traits, Alloc>& str, std::chars_format fmt = std::chars_format::general, std::span<size_t> offsets = {})
+        -> enable_if_float_t<number_of_t<const Nums>, bool> {
+        return float_to_str_batch(std::data(nums), std::size(nums), delim, str, fmt, batch_offsets(std::size(nums), offsets));
     }
+#endif
+#endif
+#ifdef CONV_ENABLE_PARALLEL
+private:
+    // chunks of values are formatted on several threads. Integers are
+    // measured first, so every chunk writes straight into its place in
+    // str. Floats cannot be measured without formatting them, so each
+    // chunk is formatted into a string of its own and then copied into
+    // place.
+    template<typename T, typename Traits, typename Alloc, typename Format>
+    [[nodiscard]] static bool format_parallel(const T* nums, size_t count, char delim, std::basic_string<char, Traits, Alloc>& str, size_t* offsets, unsigned threads, Format format) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        const size_t min_chunk = 64 * 1024;
+        if (threads <= 1 || count < 2 * min_chunk)
+            return format(nums, count, str, offsets);
 
-    // convert float to std::string
-    //===================================
-    [[nodiscard]] static bool float_to_str(float num, std::string& str, std::chars_format fmt = std::chars_format::general) {
-        try {
-            if (fmt == std::chars_format::general || fmt == std::chars_format::fixed)
-                str = std::to_string(num);
-            else if (fmt == std::chars_format::scientific)
-            {
-                const size_t len = 40;
-                char buf[len];
-                memset(buf, 0, len * sizeof(char));
-                if (SV_SPRINTF(buf, "%e", num) < 0)
-                    return false;
-                str = buf;
-            }
-            else if (fmt == std::chars_format::hex)
+        const size_t chunk = (std::max)(min_chunk, count / ((size_t)threads * 8) + 1);
+        const size_t chunks = (count + chunk - 1) / chunk;
+        auto chunk_size = [&](size_t k) {
+            return (std::min)(chunk, count - k * chunk);
+        };
+        // scratch comes from the allocator of str. starts is where each
+        // chunk starts in str, after the delimiter before it.
+        using string_type = std::basic_string<char, Traits, Alloc>;
+        const Alloc alloc = str.get_allocator();
+        std::vector<size_t, rebind_alloc_t<Alloc, size_t>> starts(chunks + 1, 0, alloc);
+        std::vector<string_type, rebind_alloc_t<Alloc, string_type>> texts(is_int_v<T> ? 0 : chunks, string_type(alloc), alloc);
+        std::atomic<bool> failed(false);
+        auto measure_task = [&](size_t k) {
+            const T* first = nums + k * chunk;
+            if constexpr (is_int_v<T>)
+                starts[k + 1] = format.length(first, chunk_size(k)) + 1;
+            else
             {
-                const size_t len = 40;
-                char buf[len];
-                memset(buf, 0, len * sizeof(char));
-                if (SV_SPRINTF(buf, "%a", num) < 0)
-                    return false;
-                str = buf;
+                if (!format(first, chunk_size(k), texts[k], offsets ? offsets + k * chunk : nullptr))
+                    failed = true;
+                starts[k + 1] = texts[k].size() + 1;
             }
+        };
+        run_parallel(chunks, threads, measure_task);
+        if (failed)
+            return false;
+        starts[0] = 0;
+        for (size_t k = 0; k < chunks; ++k)
+            starts[k + 1] += starts[k];
+
+        try {
+            str.resize(starts[chunks] - 1);
         }
         catch (std::bad_alloc&)
         {
             return false;
         }
-        return true;
-    }
-    [[nodiscard]] static bool float_to_str(double num, std::string& str, std::chars_format fmt = std::chars_format::general) {
-        try {
-            if (fmt == std::chars_format::general || fmt == std::chars_format::fixed)
-                str = std::to_string(num);
-            else if (fmt == std::chars_format::scientific)
+        auto write_task = [&](size_t k) {
+            char* const first = str.data() + starts[k];
+            const size_t n = chunk_size(k);
+            size_t* const chunk_offsets = offsets ? offsets + k * chunk : nullptr;
+            if constexpr (is_int_v<T>)
+                (void)format.write(nums + k * chunk, n, first, first + (starts[k + 1] - 1 - starts[k]), chunk_offsets);
+            else
             {
-                const size_t len = 40;
-                char buf[len];
-                memset(buf, 0, len * sizeof(char));
-                if (SV_SPRINTF(buf, "%e", num) < 0)
-                    return false;
-                str = buf;
+                memcpy(first, texts[k].data(), texts[k].size());
+                string_type(alloc).swap(texts[k]);
             }
-            else if (fmt == std::chars_format::hex)
+            if (k + 1 < chunks)
+                first[starts[k + 1] - 1 - starts[k]] = delim;
+            if (chunk_offsets)
             {
-                const size_t len = 40;
-                char buf[len];
-                memset(buf, 0, len * sizeof(char));
-                if (SV_SPRINTF(buf, "%a", num) < 0)
-                    return false;
-                str = buf;
+                for (size_t i = 0; i < n; ++i)
+                    chunk_offsets[i] += starts[k];
             }
-        }
-        catch (std::bad_alloc&)
-        {
-            return false;
-        }
+        };
+        run_parallel(chunks, threads, write_task);
         return true;
     }
-    [[nodiscard]] static bool float_to_str(float num, std::string& str, int precision) {
-		try {
-			std::ostringstream os_temp;
-
-			if (precision > 0)
-			{
-				os_temp << std::fixed << std::showpoint << std::setprecision(precision);
-			}
-
-			os_temp << num;
-
-            str = os_temp.str();
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-    [[nodiscard]] static bool float_to_str(double num, std::string& str, int precision) {
-		try {
-			std::ostringstream os_temp;
-
-			if (precision > 0)
-			{
-				os_temp << std::fixed << std::showpoint << std::setprecision(precision);
-			}
-
-			os_temp << num;
-
-			str = os_temp.str();
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-    // convert float to char*
+    template<typename T>
+    struct int_chunk_format
+    {
+        char delim;
+        int base;
+        template<typename Traits, typename Alloc>
+        [[nodiscard]] bool operator()(const T* nums, size_t count, std::basic_string<char, Traits, Alloc>& str, size_t* offsets) const {
+            return num_to_str_batch(nums, count, delim, str, base, offsets);
+        }
+        [[nodiscard]] size_t length(const T* nums, size_t count) const {
+            return int_batch_length(nums, count, base);
+        }
+        [[nodiscard]] delimited_result write(const T* nums, size_t count, char* first, char* last, size_t* offsets) const {
+            return int_batch_to_chars(nums, 0, count, delim, first, first, last, offsets, base);
+        }
+    };
+public:
+    // convert a large number array to a std::string on several threads,
+    // with the same text and offsets as num_to_str_batch().
+    // threads = 0 uses every hardware thread.
     //===================================
-    [[nodiscard]] static bool float_to_str(float num, char* str, size_t len, std::chars_format fmt = std::chars_format::general) {
-        memset(str, 0, len * sizeof(char));
-        auto ret = std::to_chars(str, str + len - 1, num, fmt);
-        return ret.ec == std::errc();
+    template<typename T, typename Traits, typename Alloc>
+    [[nodiscard]] static auto num_to_str_parallel(const T* nums, size_t count, char delim, std::basic_string<char, Traits, Alloc>& str, int base = 10, unsigned threads = 0, size_t* offsets = nullptr)
+        -> enable_if_int_t<T, bool> {
+        if (base < 2 || base > 36)
+            return false;
+        return format_parallel(nums, count, delim, str, offsets, threads, int_chunk_format<T>{ delim, base });
     }
-    [[nodiscard]] static bool float_to_str(double num, char* str, size_t len, std::chars_format fmt = std::chars_format::general) {
-        memset(str, 0, len * sizeof(char));
-        auto ret = std::to_chars(str, str + len - 1, num, fmt);
-        return ret.ec == std::errc();
+    template<typename T, typename Traits, typename Alloc>
+    [[nodiscard]] static auto float_to_str_parallel(const T* nums, size_t count, char delim, std::basic_string<char, Traits, Alloc>& str, std::chars_format fmt = std::chars_format::general, unsigned threads = 0, size_t* offsets = nullptr)
+        -> enable_if_float_t<T, bool> {
+        return format_parallel(nums, count, delim, str, offsets, threads, [delim, fmt](const T* first, size_t n, auto& text, size_t* text_offsets) {
+            return float_to_str_batch(first, n, delim, text, fmt, text_offsets);
+        });
     }
-    // convert float to std::wstring
-    //===================================
-    [[nodiscard]] static bool float_to_str(float num, std::wstring& wstr, std::chars_format fmt = std::chars_format::general) {
-        try {
-            if (fmt == std::chars_format::general || fmt == std::chars_format::fixed)
-                wstr = std::to_wstring(num);
-            else
-            {
-                std::string str;
-                if (!float_to_str(num, str, fmt))
-                    return false;
+#endif
 
-                if (!str_to_wstr(str, wstr))
-                    return false;
-            }
-        }
-        catch (std::bad_alloc&)
-        {
-            return false;
-        }
-        return true;
+#ifndef CONV_NO_ALLOC
+    [[nodiscard]] static std::string to_str(bool val)
+    {
+        return val ? "true" : "false";
     }
-    [[nodiscard]] static bool float_to_str(double num, std::wstring& wstr, std::chars_format fmt = std::chars_format::general) {
-        try {
-            if (fmt == std::chars_format::general || fmt == std::chars_format::fixed)
-                wstr = std::to_wstring(num);
-            else
-            {
-                std::string str;
-                if (!float_to_str(num, str, fmt))
-                    return false;
 
-                if (!str_to_wstr(str, wstr))
-                    return false;
-            }
+    [[nodiscard]] static std::string to_str(char val)
+    {
+        std::string str;
+        str += val;
+        return str;
+    }
+
+    // unsigned char and int8_t are converted as numbers
+    template<typename T>
+    [[nodiscard]] static auto to_str(T val) -> std::enable_if_t<is_int_v<T> || is_float_v<T>, std::string>
+    {
+        std::string str;
+        if constexpr (is_int_v<T>)
+        {
+            if (!num_to_str(val, str))
+                throw std::runtime_error("num_to_str failed");
         }
-        catch (std::bad_alloc&)
+        else
         {
-            return false;
+            if (!float_to_str(val, str))
+                throw std::runtime_error("float_to_str failed");
         }
-        return true;
+        return str;
     }
 
-    [[nodiscard]] static bool float_to_str(float num, std::wstring& str, int precision) {
-		try {
-			std::wostringstream os_temp;
-
-			if (precision > 0)
-			{
-				os_temp << std::fixed << std::showpoint << std::setprecision(precision);
-			}
-
-			os_temp << num;
-
-			str = os_temp.str();
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-    [[nodiscard]] static bool float_to_str(double num, std::wstring& str, int precision) {
-		try {
-			std::wostringstream os_temp;
-
-			if (precision > 0)
-			{
-				os_temp << std::fixed << std::showpoint << std::setprecision(precision);
-			}
-
-			os_temp << num;
-
-			str = os_temp.str();
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-
-    // convert float to wchar_t*
-    //===================================
-    [[nodiscard]] static bool float_to_str(float num, wchar_t* wstr, size_t len, std::chars_format fmt = std::chars_format::general) {
-        memset(wstr, 0, len * sizeof(wchar_t));
-        std::string str;
-        str.resize(len);
+    [[nodiscard]] static std::string to_str(const std::string& val)
+    {
+        return val;
+    }
 
-        if (float_to_str(num, str.data(), len, fmt))
-        {
-            for (size_t i = 0; i < len; ++i) {
-                if (str[i] == '\0')
-                    break;
+    [[nodiscard]] static std::string to_str(const char* val)
+    {
+        return val;
+    }
 
-                wstr[i] = str[i];
-            }
+    // other strings keep the low byte of each code unit
+    template<typename Str>
+    [[nodiscard]] static auto to_str(const Str& val) -> decltype(view_of(val), std::string())
+    {
+        std::string str;
+        if (!narrow_str(view_of(val), str))
+            throw std::runtime_error("num_to_str failed");
 
-            return true;
-        }
-        return false;
+        return str;
     }
-    [[nodiscard]] static bool float_to_str(double num, wchar_t* wstr, size_t len, std::chars_format fmt = std::chars_format::general) {
-        memset(wstr, 0, len * sizeof(wchar_t));
-        std::string str;
-        str.resize(len);
 
-        if (float_to_str(num, str.data(), len, fmt))
-        {
-            for (size_t i = 0; i < len; ++i) {
-                if (str[i] == '\0')
-                    break;
+#endif
+    // a terminated string of up to N characters held inline, which
+    // to_str_fixed() returns. It is trivially copyable and never allocates.
+    //===================================
+    template<size_t N>
+    class small_str
+    {
+        static_assert(N < 256, "small_str holds fewer than 256 characters");
+    public:
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+        [[nodiscard]] constexpr size_t size() const noexcept { return size_; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] constexpr const char* data() const noexcept { return buf_; }
+        [[nodiscard]] constexpr const char* c_str() const noexcept { return buf_; }
+        [[nodiscard]] constexpr const char* begin() const noexcept { return buf_; }
+        [[nodiscard]] constexpr const char* end() const noexcept { return buf_ + size_; }
+        [[nodiscard]] constexpr std::string_view view() const noexcept { return std::string_view(buf_, size_); }
+        constexpr operator std::string_view() const noexcept { return view(); }
 
-                wstr[i] = str[i];
-            }
+    private:
+        friend struct conv;
+        char buf_[N + 1] = {};
+        unsigned char size_ = 0;
+    };
+    // characters to_str() returns at most for T, the sign and digits of an
+    // integer, or the sign, point and exponent around the shortest round
+    // trip digits of a float
+    template<typename T>
+    static constexpr size_t fixed_capacity_v = is_float_v<T>
+        ? (size_t)std::numeric_limits<T>::max_digits10 + (std::numeric_limits<T>::max_exponent10 >= 100 ? 7 : 6)
+        : (size_t)std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>;
 
-            return true;
-        }
-        return false;
-    }
-private:
-    [[nodiscard]] static bool Is0x(const std::string_view& str, int base) {
-        return (base == 16 && (str.length() > 2 && str[0] == '0' && (str[1] == 'X' || str[1] == 'x')));
-    }
-public:
-    // convert std::string_view to number
+    // to_str() without the heap or exceptions, the capacity fits every value
     //===================================
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    template<typename T>
+    [[nodiscard]] static auto to_str_fixed(T val) noexcept
+        -> std::enable_if_t<is_int_v<T> || is_float_v<T>, small_str<fixed_capacity_v<T>>> {
+        small_str<fixed_capacity_v<T>> str;
+        char* const first = str.buf_;
+        std::to_chars_result ret;
+        if constexpr (is_int_v<T>)
+            ret = dec_to_chars(first, first + str.capacity(), val);
+        else
+            ret = float_to_chars(first, first + str.capacity(), val, std::chars_format::general);
+        if (ret.ec == std::errc())
+            str.size_ = (unsigned char)(ret.ptr - first);
+        str.buf_[str.size_] = '\0';
+        return str;
     }
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    [[nodiscard]] static constexpr small_str<5> to_str_fixed(bool val) noexcept {
+        small_str<5> str;
+        const std::string_view text = val ? "true" : "false";
+        for (char c : text)
+            str.buf_[str.size_++] = c;
+        return str;
     }
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    [[nodiscard]] static constexpr small_str<1> to_str_fixed(char val) noexcept {
+        small_str<1> str;
+        str.buf_[0] = val;
+        str.size_ = 1;
+        return str;
     }
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+
+    // number of characters num_to_str() writes to a std::basic_string,
+    // 0 for a base it does not take, so a string can be reserved once
+    //===================================
+    template<typename T>
+    [[nodiscard]] static constexpr auto formatted_size(T num, int base = 10)
+        -> enable_if_int_t<T, size_t> {
+        if (base == 10)
+        {
+            const bool neg = num < 0;
+            return neg + (size_t)dec_digit_count(neg ? 0 - (std::uint64_t)num : (std::uint64_t)num);
+        }
+        const int shift = radix_shift(base);
+        if (shift == 0)
+            return 0;
+        using promoted = std::make_unsigned_t<std::common_type_t<T, int>>;
+        return (size_t)((64 - leading_zeros((std::uint64_t)(promoted)num | 1) + shift - 1) / shift);
     }
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    // number of characters float_to_str() writes
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto formatted_size(T num, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, size_t> {
+        char buf[400];
+        return (size_t)(float_to_chars(buf, buf + sizeof(buf), num, fmt).ptr - buf);
     }
-    [[nodiscard]] static bool str_to_num(const std::string_view& str, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        size_t offset = Is0x(str, base) ? 2 : 0;
-        auto ret = std::from_chars(str.data() + offset, str.data() + str.length(), num, base);
-        if (ec) *ec = ret.ec;
-        return ret.ec == std::errc();
+    template<typename T>
+    [[nodiscard]] static auto formatted_size(T num, int precision)
+        -> enable_if_float_t<T, size_t> {
+        size_t size = 0;
+        (void)emit([&size](auto first, auto last, size_t zeros = 0) {
+            size = (size_t)(last - first) + zeros;
+            return true;
+        }, num, precision);
+        return size;
     }
-    // convert std::string to number
+    // number of characters to_str() returns
     //===================================
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    [[nodiscard]] static constexpr size_t formatted_size(bool val) {
+        return val ? 4 : 5;
     }
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    [[nodiscard]] static constexpr size_t formatted_size(char) {
+        return 1;
     }
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    template<typename Str>
+    [[nodiscard]] static auto formatted_size(const Str& val) -> decltype(view_of(val).size()) {
+        return view_of(val).size();
     }
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+private:
+    // the emit() overloads pass the text of a value to
+    // sink(first, last, zeros), zeros being a count of '0' characters
+    // after [first, last), as num_to_str(), float_to_str() and to_str()
+    // write it to a string
+    template<typename Sink, typename T>
+    [[nodiscard]] static auto emit(Sink&& sink, T num, int base = 10, digit_case letters = digit_case::upper)
+        -> enable_if_int_t<T, bool> {
+        char buf[72];
+        const auto ret = format_int(buf, num, base, letters);
+        return ret.ec == std::errc() && sink((const char*)buf, (const char*)ret.ptr);
     }
-    [[nodiscard]] static bool str_to_num(const std::string& str, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    template<typename Sink, typename T>
+    [[nodiscard]] static auto emit(Sink&& sink, T num, std::chars_format fmt = std::chars_format::general)
+        -> enable_if_float_t<T, bool> {
+        char buf[400];
+        const auto ret = float_to_chars(buf, buf + sizeof(buf), num, fmt);
+        return ret.ec == std::errc() && sink((const char*)buf, (const char*)ret.ptr);
     }
-    // convert const char* to number
-    //===================================
-    [[nodiscard]] static bool str_to_num(const char* str, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+    template<typename Sink, typename T>
+    [[nodiscard]] static auto emit(Sink&& sink, T num, int precision)
+        -> enable_if_float_t<T, bool> {
+        char buf[1400];
+        size_t zeros;
+        const auto ret = format_float(buf, num, precision, zeros);
+        return ret.ec == std::errc() && sink((const char*)buf, (const char*)ret.ptr, zeros);
     }
-    [[nodiscard]] static bool str_to_num(const char* str, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+    template<typename Sink>
+    [[nodiscard]] static bool emit(Sink&& sink, bool val) {
+        const char* text = val ? "true" : "false";
+        return sink(text, text + formatted_size(val));
     }
-    [[nodiscard]] static bool str_to_num(const char* str, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+    template<typename Sink>
+    [[nodiscard]] static bool emit(Sink&& sink, char val) {
+        return sink(&val, &val + 1);
     }
-    [[nodiscard]] static bool str_to_num(const char* str, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+    template<typename Sink, typename Str>
+    [[nodiscard]] static auto emit(Sink&& sink, const Str& val) -> decltype(view_of(val), bool()) {
+        const auto view = view_of(val);
+        return sink(view.data(), view.data() + view.size());
     }
-    [[nodiscard]] static bool str_to_num(const char* str, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+#ifndef CONV_NO_ALLOC
+    // append code units to str, converting them to CharT one by one when
+    // the types differ. On failure str is left as it was.
+    template<typename CharT, typename Traits, typename Alloc>
+    struct string_sink
+    {
+        std::basic_string<CharT, Traits, Alloc>& str;
+
+        template<typename U>
+        [[nodiscard]] bool operator()(const U* first, const U* last, size_t zeros = 0) const {
+            const size_t size = str.size();
+            CONV_STAT(count_growth(str, size + (size_t)(last - first) + zeros);)
+            try {
+                str.reserve(size + (size_t)(last - first) + zeros);
+                if constexpr (std::is_same_v<U, CharT>)
+                    str.append(first, last);
+                else
+                {
+                    for (; first != last; ++first)
+                        str.push_back((CharT)*first);
+                }
+                str.append(zeros, (CharT)'0');
+            }
+            catch (std::bad_alloc&)
+            {
+                str.resize(size);
+                return false;
+            }
+            return true;
+        }
+    };
+#endif
+    // the code unit an output iterator takes: the element of the container
+    // of an insert iterator, the char_type of a stream iterator or the
+    // value type, void when the iterator does not tell
+    template<typename OutIt, typename = void>
+    struct out_unit { using type = typename std::iterator_traits<OutIt>::value_type; };
+    template<typename OutIt>
+    struct out_unit<OutIt, std::void_t<typename OutIt::container_type>> { using type = typename OutIt::container_type::value_type; };
+    template<typename OutIt>
+    struct out_unit<OutIt, std::void_t<typename OutIt::char_type>> { using type = typename OutIt::char_type; };
+    // code units are converted to the unit of the iterator as the string
+    // overloads convert them, a char keeps the low byte of a wide one
+    template<typename OutIt>
+    struct iterator_sink
+    {
+        OutIt& out;
+        using unit = typename out_unit<OutIt>::type;
+
+        template<typename U>
+        [[nodiscard]] bool operator()(const U* first, const U* last, size_t zeros = 0) const {
+            using V = std::conditional_t<std::is_void_v<unit>, U, unit>;
+            for (; first != last; ++first)
+                *out++ = (V)*first;
+            for (; zeros != 0; --zeros)
+                *out++ = (V)'0';
+            return true;
+        }
+    };
+public:
+#ifndef CONV_NO_ALLOC
+    // append the text of a number, float, bool, char or string to str,
+    // with the same arguments and text as num_to_str(), float_to_str()
+    // and to_str(). Nothing is allocated when str has the capacity.
+    //===================================
+    template<typename CharT, typename Traits, typename Alloc, typename... Args>
+    [[nodiscard]] static auto append(std::basic_string<CharT, Traits, Alloc>& str, const Args&... args)
+        -> std::enable_if_t<is_char_v<CharT>, decltype(emit(std::declval<string_sink<CharT, Traits, Alloc>>(), args...))> {
+        return emit(string_sink<CharT, Traits, Alloc>{ str }, args...);
     }
-    [[nodiscard]] static bool str_to_num(const char* str, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        return str_to_num(std::string_view(str), num, base, ec);
+#endif
+    // write the same text to an output iterator, returns the iterator past
+    // it. Nothing is written when append() would fail.
+    //===================================
+    template<typename OutIt, typename... Args>
+    static auto format_to(OutIt out, const Args&... args)
+        -> std::enable_if_t<std::is_same_v<decltype(emit(std::declval<iterator_sink<OutIt>>(), args...)), bool>, OutIt> {
+        (void)emit(iterator_sink<OutIt>{ out }, args...);
+        return out;
     }
-    // convert std::wstring_view to number
+    // appends text to a character array of a fixed size or to a
+    // std::basic_string<char> that grows, with any allocator. A write that
+    // does not fit in the array fails and leaves it as it was, and the
+    // array is always terminated.
     //===================================
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+    class writer
+    {
+    public:
+        // len characters at buf, including the terminator
+        writer(char* buf, size_t len)
+            : buf_(buf), capacity_(len != 0 ? len - 1 : 0) {
+            if (len != 0)
+                buf[0] = '\0';
+        }
+#ifndef CONV_NO_ALLOC
+        // appends to str
+        template<typename Traits, typename Alloc>
+        explicit writer(std::basic_string<char, Traits, Alloc>& str)
+            : str_(&str), append_(&append_to<Traits, Alloc>), view_(&view_of_string<Traits, Alloc>) {}
+#endif
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+        // write the text of a value as append() does
+        template<typename... Args>
+        [[nodiscard]] auto write(const Args&... args)
+            -> decltype(emit(std::declval<writer&>(), args...)) {
+            return emit(*this, args...);
+        }
+        // the text so far
+        [[nodiscard]] std::string_view view() const {
+            return str_ ? view_(str_) : std::string_view(buf_, size_);
+        }
+        [[nodiscard]] const char* data() const {
+            return view().data();
+        }
+        [[nodiscard]] size_t size() const {
+            return view().size();
+        }
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+        template<typename U>
+        [[nodiscard]] bool operator()(const U* first, const U* last, size_t zeros = 0) {
+            if (str_)
+            {
+                if constexpr (std::is_same_v<U, char>)
+                    return append_(str_, first, last, zeros);
+                else
+                {
+                    // narrowed a block at a time
+                    char block[256];
+                    while (first != last)
+                    {
+                        const size_t n = (std::min)((size_t)(last - first), sizeof(block));
+                        for (size_t i = 0; i < n; ++i)
+                            block[i] = (char)first[i];
+                        first += n;
+                        if (!append_(str_, block, block + n, first == last ? zeros : 0))
+                            return false;
+                    }
+                    return true;
+                }
+            }
+            const size_t n = (size_t)(last - first);
+            if (capacity_ - size_ < n || capacity_ - size_ - n < zeros)
+                return false;
+            char* p = buf_ + size_;
+            for (; first != last; ++first)
+                *p++ = (char)*first;
+            memset(p, '0', zeros);
+            size_ += n + zeros;
+            buf_[size_] = '\0';
+            return true;
+        }
+    private:
+#ifndef CONV_NO_ALLOC
+        template<typename Traits, typename Alloc>
+        static bool append_to(void* str, const char* first, const char* last, size_t zeros) {
+            return string_sink<char, Traits, Alloc>{ *static_cast<std::basic_string<char, Traits, Alloc>*>(str) }(first, last, zeros);
+        }
+        template<typename Traits, typename Alloc>
+        static std::string_view view_of_string(const void* str) {
+            const auto& text = *static_cast<const std::basic_string<char, Traits, Alloc>*>(str);
+            return std::string_view(text.data(), text.size());
+        }
+#endif
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+        // the growable string, erased to its allocator
+        void* str_ = nullptr;
+        bool (*append_)(void*, const char*, const char*, size_t) = nullptr;
+        std::string_view (*view_)(const void*) = nullptr;
+        // or the fixed array
+        char* buf_ = nullptr;
+        size_t capacity_ = 0;
+        size_t size_ = 0;
+    };
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+#ifndef CONV_NO_ALLOC
+    // to_str() into a string drawn from alloc. An allocator of wchar_t
+    // gives a std::basic_string<wchar_t>, any other a std::basic_string<char>.
+    //===================================
+    template<typename T, typename Alloc, typename CharT = std::conditional_t<std::is_same_v<typename Alloc::value_type, wchar_t>, wchar_t, char>,
+        typename String = std::basic_string<CharT, std::char_traits<CharT>, rebind_alloc_t<Alloc, CharT>>>
+    [[nodiscard]] static auto to_str(const T& val, const Alloc& alloc)
+        -> decltype(std::declval<Alloc&>().allocate(1), append(std::declval<String&>(), val), String()) {
+        String str(alloc);
+        if (!append(str, val))
+            throw std::runtime_error("to_str failed");
+        return str;
     }
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+#endif
+#ifdef CONV_ENABLE_PMR
+    // to_str() into a std::pmr::string drawn from resource
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto to_str(const T& val, std::pmr::memory_resource* resource)
+        -> decltype(to_str(val, std::pmr::polymorphic_allocator<char>(resource))) {
+        return to_str(val, std::pmr::polymorphic_allocator<char>(resource));
     }
-    [[nodiscard]] static bool str_to_num(const std::wstring_view& wstr, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    // to_str() into a std::pmr::wstring drawn from resource
+    //===================================
+    template<typename T>
+    [[nodiscard]] static auto to_wstr(const T& val, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        -> decltype(to_str(val, std::pmr::polymorphic_allocator<wchar_t>(resource))) {
+        return to_str(val, std::pmr::polymorphic_allocator<wchar_t>(resource));
     }
-
-    // convert std::wstring to number
+#endif
+#ifdef CONV_ENABLE_STATS
+public:
+    // counters of the run-time calls of every family in every thread
+    // since the program started. Subtract an earlier snapshot for the
+    // calls in between.
     //===================================
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+    struct stats_snapshot
+    {
+        static constexpr int latency_buckets = 16;
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+        struct family_stats
+        {
+            std::uint64_t calls = 0;
+            // characters parsed or written, in bytes
+            std::uint64_t bytes = 0;
+            // failures by std::errc, in the order of failure_codes
+            std::uint64_t errors[4] = {};
+            // one call in CONV_STATS_SAMPLE_RATE is timed, latency[i]
+            // counts those that took under 2^(i + 4) ns and the last
+            // bucket the slower ones
+            std::uint64_t latency[latency_buckets] = {};
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+            [[nodiscard]] std::uint64_t failures() const {
+                return errors[0] + errors[1] + errors[2] + errors[3];
+            }
+            [[nodiscard]] std::uint64_t failures(std::errc ec) const {
+                return ec == std::errc() ? 0 : errors[failure_slot(ec)];
+            }
+        };
+        static constexpr std::errc failure_codes[4] = { std::errc::invalid_argument,
+            std::errc::result_out_of_range, std::errc::value_too_large, std::errc::not_enough_memory };
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+        family_stats families[stat_families];
+        // strings conv had to grow to hold its text
+        std::uint64_t allocations = 0;
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+        [[nodiscard]] const family_stats& operator[](stat_family family) const {
+            return families[(int)family];
+        }
+        friend stats_snapshot operator-(stats_snapshot a, const stats_snapshot& b) {
+            for (int f = 0; f < stat_families; ++f)
+            {
+                family_stats& x = a.families[f];
+                const family_stats& y = b.families[f];
+                x.calls -= y.calls;
+                x.bytes -= y.bytes;
+                for (int i = 0; i < 4; ++i)
+                    x.errors[i] -= y.errors[i];
+                for (int i = 0; i < latency_buckets; ++i)
+                    x.latency[i] -= y.latency[i];
+            }
+            a.allocations -= b.allocations;
+            return a;
+        }
+    };
+    // sum the counters of every thread, the threads keep counting while
+    // it runs
+    //===================================
+    [[nodiscard]] static stats_snapshot stats() {
+        stats_snapshot snap;
+        add_stats(snap, shared_stats());
+        for (const stats_block* block = stats_blocks().load(std::memory_order_acquire); block; block = block->next)
+            add_stats(snap, *block);
+        return snap;
     }
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+private:
+    [[nodiscard]] static constexpr int failure_slot(std::errc ec) {
+        return ec == std::errc::result_out_of_range ? 1
+            : ec == std::errc::value_too_large ? 2
+            : ec == std::errc::not_enough_memory ? 3 : 0;
     }
-    [[nodiscard]] static bool str_to_num(const std::wstring& wstr, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    struct family_counters
+    {
+        std::atomic<std::uint64_t> calls;
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::uint64_t> errors[4];
+        std::atomic<std::uint64_t> latency[stats_snapshot::latency_buckets];
+    };
+    // the counters of one thread, on cache lines of their own so that
+    // threads do not write to the same line. A block outlives its thread
+    // and is taken over by the next thread that starts.
+    struct alignas(64) stats_block
+    {
+        family_counters families[stat_families];
+        std::atomic<std::uint64_t> allocations;
+        std::atomic<bool> in_use;
+        stats_block* next;
+        // calls since the last timed one, read by the owner alone
+        unsigned ticks;
+    };
+    // a block has a single writer, so a relaxed load and store is enough
+    // and there is no locked instruction on the path of a call
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
     }
-    // convert const wchar_t* to number
-    //===================================
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::int16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    static void add_stats(stats_snapshot& snap, const stats_block& block) {
+        for (int f = 0; f < stat_families; ++f)
+        {
+            stats_snapshot::family_stats& to = snap.families[f];
+            const family_counters& from = block.families[f];
+            to.calls += from.calls.load(std::memory_order_relaxed);
+            to.bytes += from.bytes.load(std::memory_order_relaxed);
+            for (int i = 0; i < 4; ++i)
+                to.errors[i] += from.errors[i].load(std::memory_order_relaxed);
+            for (int i = 0; i < stats_snapshot::latency_buckets; ++i)
+                to.latency[i] += from.latency[i].load(std::memory_order_relaxed);
+        }
+        snap.allocations += block.allocations.load(std::memory_order_relaxed);
     }
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::uint16_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    // blocks are pushed on a lock-free list and never freed
+    [[nodiscard]] static std::atomic<stats_block*>& stats_blocks() {
+        static std::atomic<stats_block*> head{ nullptr };
+        return head;
     }
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::int32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
-
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+    // counts the threads that found no memory for a block of their own,
+    // losing an increment when two of them race
+    [[nodiscard]] static stats_block& shared_stats() {
+        static stats_block block{};
+        return block;
     }
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::uint32_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+    [[nodiscard]] static stats_block* acquire_stats_block() {
+        std::atomic<stats_block*>& head = stats_blocks();
+        for (stats_block* block = head.load(std::memory_order_acquire); block; block = block->next)
+        {
+            bool idle = false;
+            if (!block->in_use.load(std::memory_order_relaxed)
+                && block->in_use.compare_exchange_strong(idle, true, std::memory_order_acquire))
+                return block;
+        }
+        stats_block* block = new (std::nothrow) stats_block();
+        if (!block)
+            return &shared_stats();
+        block->in_use.store(true, std::memory_order_relaxed);
+        block->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+            ;
+        return block;
+    }
+    struct stats_owner
+    {
+        stats_block* block = acquire_stats_block();
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+        ~stats_owner() {
+            block->in_use.store(false, std::memory_order_release);
+        }
+    };
+    [[nodiscard]] static stats_block& thread_stats() {
+        thread_local stats_owner owner;
+        return *owner.block;
     }
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::int64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
+    static void count_allocation() {
+        bump(thread_stats().allocations, 1);
+    }
+    // count the allocation when str cannot hold size characters
+    template<typename String>
+    static void count_growth(const String& str, size_t size) {
+        if (str.capacity() < size)
+            count_allocation();
+    }
+    // counts a call of family in the block of the thread when it ends
+    class stat_call
+    {
+    public:
+        // a parse of bytes of text whose result is *ec, which is pointed
+        // at a member when the caller passed no ec
+        stat_call(stat_family family, size_t bytes, std::errc*& ec)
+            : stat_call(family, std::errc()) {
+            bytes_ = bytes;
+            if (!ec)
+                ec = &ec_;
+            result_ = ec;
+        }
+        // a format that failed with failure unless result() is called
+        stat_call(stat_family family, std::errc failure)
+            : block_(thread_stats()), family_(family), ec_(failure),
+            timed_(++block_.ticks % CONV_STATS_SAMPLE_RATE == 0) {
+            if (timed_)
+                start_ = std::chrono::steady_clock::now();
+        }
+        stat_call(const stat_call&) = delete;
+        stat_call& operator=(const stat_call&) = delete;
+        ~stat_call() {
+            family_counters& counters = block_.families[(int)family_];
+            bump(counters.calls, 1);
+            bump(counters.bytes, bytes_);
+            if (*result_ != std::errc())
+                bump(counters.errors[failure_slot(*result_)], 1);
+            if (timed_)
+            {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_).count();
+                int bucket = 0;
+                while (bucket < stats_snapshot::latency_buckets - 1 && ns >= (16LL << bucket))
+                    ++bucket;
+                bump(counters.latency[bucket], 1);
+            }
+        }
+        void result(std::errc ec, size_t bytes) {
+            ec_ = ec;
+            bytes_ = bytes;
+        }
+    private:
+        stats_block& block_;
+        stat_family family_;
+        size_t bytes_ = 0;
+        std::errc ec_;
+        const std::errc* result_ = &ec_;
+        bool timed_;
+        std::chrono::steady_clock::time_point start_;
+    };
+#endif
+
+};
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
+// integer literals checked at compile time, after
+// using namespace conv_literals:
+//   0x1F_u32, 0b1010_u8, 1'000'000_i64, "0x1F"_u32, "-128"_i8
+// A literal that is out of range or not an integer fails to compile. The
+// string form is consteval in C++20 and constexpr before it, so that it
+// is only checked in a constant expression.
+namespace conv_literals
+{
+    template<typename T, char... Chars>
+    constexpr T literal_value() {
+        constexpr char text[] = { Chars... };
+        constexpr T value = conv::from_literal<T>(text, text + sizeof...(Chars));
+        return value;
     }
-    [[nodiscard]] static bool str_to_num(const wchar_t* wstr, std::uint64_t& num, int base = 10, std::errc* ec = nullptr) {
-        std::string str;
-        if (!wstr_to_str(wstr, str))
-            return false;
 
-        return str_to_num(std::string_view(str.c_str(), str.size()), num, base, ec);
-    }
-	// convert number to std::string
-	//===================================
-	[[nodiscard]] static bool num_to_str(std::int16_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string((int)num);
-			else if (base == 8)
-			{
-				const size_t len = 10;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%o", num) < 0)
-					return false;
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 10;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%X", num) < 0)
-					return false;
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint16_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string((unsigned int)num);
-			else if (base == 8)
-			{
-				const size_t len = 10;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%o", num) < 0)
-					return false;
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 10;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%X", num) < 0)
-					return false;
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::int32_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string(num);
-			else if (base == 8)
-			{
-				const size_t len = 20;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%o", num) < 0)
-					return false;
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 20;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%X", num) < 0)
-					return false;
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint32_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string(num);
-			else if (base == 8)
-			{
-				const size_t len = 20;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%o", num) < 0)
-					return false;
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 20;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-				if (SV_SPRINTF(buf, "%X", num) < 0)
-					return false;
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::int64_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string(num);
-			else if (base == 8)
-			{
-				const size_t len = 40;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-#ifdef _WIN32
-				if (SV_SPRINTF(buf, "%llo", num) < 0)
-					return false;
-#else
-				if (SV_SPRINTF(buf, "%lo", num) < 0)
-					return false;
-#endif
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 40;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-#ifdef _WIN32
-				if (SV_SPRINTF(buf, "%llX", num) < 0)
-					return false;
-#else
-				if (SV_SPRINTF(buf, "%lX", num) < 0)
-					return false;
-#endif
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint64_t num, std::string& str, int base = 10) {
-		try {
-			if (base == 10)
-				str = std::to_string(num);
-			else if (base == 8)
-			{
-				const size_t len = 40;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-#ifdef _WIN32
-				if (SV_SPRINTF(buf, "%llo", num) < 0)
-					return false;
-#else
-				if (SV_SPRINTF(buf, "%lo", num) < 0)
-					return false;
-#endif
-				str = buf;
-			}
-			else if (base == 16)
-			{
-				const size_t len = 40;
-				char buf[len];
-				memset(buf, 0, len * sizeof(char));
-#ifdef _WIN32
-				if (SV_SPRINTF(buf, "%llX", num) < 0)
-					return false;
-#else
-				if (SV_SPRINTF(buf, "%lX", num) < 0)
-					return false;
-#endif
-				str = buf;
-			}
-			else
-				return false;
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	// convert number to char*
-	//===================================
-	[[nodiscard]] static bool num_to_str(std::int16_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	[[nodiscard]] static bool num_to_strnum_to_str(std::uint16_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	[[nodiscard]] static bool num_to_str(std::int32_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	[[nodiscard]] static bool num_to_str(std::uint32_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	[[nodiscard]] static bool num_to_str(std::int64_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	[[nodiscard]] static bool num_to_str(std::uint64_t num, char* str, size_t len, int base = 10) {
-		memset(str, 0, len * sizeof(char));
-		auto ret = std::to_chars(str, str + len - 1, num, base);
-		return ret.ec == std::errc();
-	}
-	// convert number to std::wstring
-	//===================================
-	[[nodiscard]] static bool num_to_str(std::int16_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring((int)num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint16_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring((unsigned int)num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::int32_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring(num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint32_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring(num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::int64_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring(num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint64_t num, std::wstring& wstr, int base = 10) {
-		try {
-			if (base == 10)
-				wstr = std::to_wstring(num);
-			else
-			{
-				std::string str;
-				if (!num_to_str(num, str, base))
-					return false;
-
-				if (!str_to_wstr(str, wstr))
-					return false;
-			}
-		}
-		catch (std::bad_alloc&)
-		{
-			return false;
-		}
-		return true;
-	}
-	// convert number to wchar_t*
-	//===================================
-	[[nodiscard]] static bool num_to_str(std::int16_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint16_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static bool num_to_str(std::int32_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint32_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static bool num_to_str(std::int64_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static bool num_to_str(std::uint64_t num, wchar_t* wstr, size_t len, int base = 10) {
-		memset(wstr, 0, len * sizeof(wchar_t));
-		std::string str;
-		str.resize(len);
-
-		if (num_to_str(num, str.data(), len, base))
-		{
-			for (size_t i = 0; i < len; ++i) {
-				if (str[i] == '\0')
-					break;
-
-				wstr[i] = str[i];
-			}
-
-			return true;
-		}
-		return false;
-	}
-	[[nodiscard]] static std::string to_str(bool val)
-	{
-		return val ? "true" : "false";
-	}
-
-	[[nodiscard]] static std::string to_str(int16_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(int32_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(int64_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(uint16_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(uint32_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(uint64_t val)
-	{
-		std::string str;
-		if (!num_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(float val)
-	{
-		std::string str;
-		if (!float_to_str(val, str))
-			throw std::runtime_error("float_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(double val)
-	{
-		std::string str;
-		if (!float_to_str(val, str))
-			throw std::runtime_error("float_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(char val)
-	{
-		std::string str;
-		str += val;
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(unsigned char val)
-	{
-		std::string str;
-		uint16_t val2 = val;
-		if (!num_to_str(val2, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(const std::string& val)
-	{
-		return val;
-	}
-
-	[[nodiscard]] static std::string to_str(const char* val)
-	{
-		return val;
-	}
-
-	[[nodiscard]] static std::string to_str(const std::wstring& val)
-	{
-		std::string str;
-		if (!wstr_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
-
-	[[nodiscard]] static std::string to_str(const wchar_t* val)
-	{
-		std::string str;
-		if (!wstr_to_str(val, str))
-			throw std::runtime_error("num_to_str failed");
-
-		return str;
-	}
+    template<char... Chars> constexpr std::int8_t operator""_i8() { return literal_value<std::int8_t, Chars...>(); }
+    template<char... Chars> constexpr std::uint8_t operator""_u8() { return literal_value<std::uint8_t, Chars...>(); }
+    template<char... Chars> constexpr std::int16_t operator""_i16() { return literal_value<std::int16_t, Chars...>(); }
+    template<char... Chars> constexpr std::uint16_t operator""_u16() { return literal_value<std::uint16_t, Chars...>(); }
+    template<char... Chars> constexpr std::int32_t operator""_i32() { return literal_value<std::int32_t, Chars...>(); }
+    template<char... Chars> constexpr std::uint32_t operator""_u32() { return literal_value<std::uint32_t, Chars...>(); }
+    template<char... Chars> constexpr std::int64_t operator""_i64() { return literal_value<std::int64_t, Chars...>(); }
+    template<char... Chars> constexpr std::uint64_t operator""_u64() { return literal_value<std::uint64_t, Chars...>(); }
 
-};
+    CONV_CONSTEVAL std::int8_t operator""_i8(const char* str, size_t len) { return conv::from_literal<std::int8_t>(str, str + len); }
+    CONV_CONSTEVAL std::uint8_t operator""_u8(const char* str, size_t len) { return conv::from_literal<std::uint8_t>(str, str + len); }
+    CONV_CONSTEVAL std::int16_t operator""_i16(const char* str, size_t len) { return conv::from_literal<std::int16_t>(str, str + len); }
+    CONV_CONSTEVAL std::uint16_t operator""_u16(const char* str, size_t len) { return conv::from_literal<std::uint16_t>(str, str + len); }
+    CONV_CONSTEVAL std::int32_t operator""_i32(const char* str, size_t len) { return conv::from_literal<std::int32_t>(str, str + len); }
+    CONV_CONSTEVAL std::uint32_t operator""_u32(const char* str, size_t len) { return conv::from_literal<std::uint32_t>(str, str + len); }
+    CONV_CONSTEVAL std::int64_t operator""_i64(const char* str, size_t len) { return conv::from_literal<std::int64_t>(str, str + len); }
+    CONV_CONSTEVAL std::uint64_t operator""_u64(const char* str, size_t len) { return conv::from_literal<std::uint64_t>(str, str + len); }
+}
@@ -0,0 +1,93 @@
+// Throughput of conv::num_to_str_batch() and conv::float_to_str_batch()
+// against formatting each value to a std::string and appending it, on a
+// seeded column of numbers. Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -ITestTo bench/batch_format.cpp -o batch_format && ./batch_format
+#define CONV_ENABLE_PARALLEL
+#include "conv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// best of 5 runs, in ns per number
+template<typename Run>
+double time_run(size_t count, Run run)
+{
+	double best = 1e300;
+	for (int r = 0; r < 5; ++r)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const size_t bytes = run();
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double)count;
+		if (bytes == 42)
+			std::printf("unlikely\n");
+		if (ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+void report(const char* impl, const char* data, double ns)
+{
+	std::printf("%-28s %-10s %8.2f ns/number\n", impl, data, ns);
+}
+
+int main()
+{
+	const size_t count = 2000000;
+	std::mt19937_64 rng(12345);
+	std::vector<std::int64_t> ints(count);
+	for (std::int64_t& n : ints)
+		n = (std::int64_t)(rng() >> (rng() % 64));
+	std::vector<double> doubles(count);
+	for (double& d : doubles)
+		d = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+
+	report("num_to_str + append", "int64", time_run(count, [&ints]() {
+		std::string out;
+		for (std::int64_t n : ints)
+		{
+			std::string str;
+			(void)conv::num_to_str(n, str);
+			out += str;
+			out += ',';
+		}
+		return out.size();
+	}));
+	report("num_to_str_batch string", "int64", time_run(count, [&ints]() {
+		std::string out;
+		(void)conv::num_to_str_batch(ints.data(), ints.size(), ',', out);
+		return out.size();
+	}));
+	report("num_to_str_parallel", "int64", time_run(count, [&ints]() {
+		std::string out;
+		(void)conv::num_to_str_parallel(ints.data(), ints.size(), ',', out);
+		return out.size();
+	}));
+
+	report("float_to_str + append", "double", time_run(count, [&doubles]() {
+		std::string out;
+		for (double d : doubles)
+		{
+			std::string str;
+			(void)conv::float_to_str(d, str);
+			out += str;
+			out += ',';
+		}
+		return out.size();
+	}));
+	report("float_to_str_batch string", "double", time_run(count, [&doubles]() {
+		std::string out;
+		(void)conv::float_to_str_batch(doubles.data(), doubles.size(), ',', out);
+		return out.size();
+	}));
+	report("float_to_str_parallel", "double", time_run(count, [&doubles]() {
+		std::string out;
+		(void)conv::float_to_str_parallel(doubles.data(), doubles.size(), ',', out);
+		return out.size();
+	}));
+	return 0;
+}
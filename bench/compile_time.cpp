@@ -0,0 +1,25 @@
+// Translation unit for bench/compile_time.sh. It only uses the functions
+// every version of conv.h has, so that old revisions compile it too.
+#include "conv.h"
+
+#ifndef CONV_BENCH_INCLUDE_ONLY
+#include <string>
+
+bool use_conv(const std::string& text, const wchar_t* wtext, std::string& out, std::wstring& wout)
+{
+	std::int32_t i = 0;
+	std::uint64_t u = 0;
+	std::int16_t s = 0;
+	double d = 0;
+	float f = 0;
+	bool ok = conv::str_to_num(text, i) && conv::str_to_num(text.c_str(), u, 16) && conv::str_to_num(wtext, s);
+	ok = ok && conv::str_to_float(text, d) && conv::str_to_float(wtext, f);
+	ok = ok && conv::num_to_str(i, out) && conv::num_to_str(u, wout, 16) && conv::float_to_str(d, out, 3);
+
+	char buf[32];
+	wchar_t wbuf[32];
+	ok = ok && conv::num_to_str(s, buf, 32) && conv::float_to_str(f, wbuf, 32);
+	out += conv::to_str(d) + conv::to_str(u) + conv::to_str(wtext);
+	return ok;
+}
+#endif
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Compile time of conv.h against the conv.h of another git revision.
+#
+# usage: bench/compile_time.sh [revision] [runs]
+#
+# Compiles bench/compile_time.cpp with the working tree conv.h and with
+# the conv.h of revision (default HEAD), once with only the #include and
+# once using a typical mix of functions, and prints the best of runs
+# (default 5). Set CXX and CXXFLAGS to change the compiler and flags.
+set -e
+
+rev=${1:-HEAD}
+runs=${2:-5}
+cxx=${CXX:-c++}
+flags=${CXXFLAGS:--std=c++17 -O0}
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+mkdir "$tmp/old" "$tmp/new"
+git -C "$root" show "$rev:TestTo/conv.h" > "$tmp/old/conv.h"
+cp "$root/TestTo/conv.h" "$tmp/new/conv.h"
+
+TIMEFORMAT=%R
+best_time() {
+	local best=
+	for ((i = 0; i < runs; ++i)); do
+		local t
+		t=$( { time $cxx $flags "$@" -I"$dir" -c "$root/bench/compile_time.cpp" -o "$tmp/out.o" ; } 2>&1 )
+		if [[ -z $best ]] || awk "BEGIN { exit !($t < $best) }"; then
+			best=$t
+		fi
+	done
+	echo "$best"
+}
+
+printf '%-24s %12s %12s\n' "" "$rev" "working tree"
+for mode in include usage; do
+	extra=
+	[[ $mode == include ]] && extra=-DCONV_BENCH_INCLUDE_ONLY
+	dir=$tmp/old; old=$(best_time $extra)
+	dir=$tmp/new; new=$(best_time $extra)
+	printf '%-24s %11ss %11ss\n' "$mode" "$old" "$new"
+done
@@ -0,0 +1,472 @@
+// Throughput of every conv overload family against std::from_chars(),
+// std::to_chars(), strtol(), sscanf(), snprintf(), std::stoi() and
+// std::stringstream on seeded datasets, in ns/op, MB/s of text and heap
+// allocations per op. Build with CMake from the repository root:
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target conv_bench
+//   ./build/conv_bench [--count N] [filter]
+// or directly:
+//   g++ -std=c++17 -O2 -ITestTo bench/conv_bench.cpp -o conv_bench && ./conv_bench
+// A filter runs only the rows whose family, implementation or dataset
+// contains it, e.g. ./conv_bench hex
+#include "conv.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// every allocation of the process goes through here to be counted
+static std::uint64_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	if (void* p = std::malloc(size != 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+struct dataset
+{
+	const char* name;
+	int base = 10;
+	std::vector<std::int64_t> ints;
+	std::vector<double> floats;
+	std::vector<std::string> strs;
+	std::vector<std::wstring> wstrs;
+	size_t bytes = 0;
+};
+
+std::wstring widen(const std::string& s)
+{
+	return std::wstring(s.begin(), s.end());
+}
+
+// integers and their text, make returns the next value
+template<typename Make>
+dataset make_int_dataset(const char* name, int base, size_t count, Make make)
+{
+	dataset data;
+	data.name = name;
+	data.base = base;
+	std::mt19937_64 rng(12345);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const std::int64_t n = make(rng);
+		char buf[72];
+		*std::to_chars(buf, buf + sizeof(buf), n, base).ptr = '\0';
+		data.ints.push_back(n);
+		data.strs.emplace_back(buf);
+		data.wstrs.push_back(widen(data.strs.back()));
+		data.bytes += data.strs.back().size();
+	}
+	return data;
+}
+
+// doubles and their shortest round trip text
+template<typename Make>
+dataset make_float_dataset(const char* name, size_t count, Make make)
+{
+	dataset data;
+	data.name = name;
+	std::mt19937_64 rng(12345);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const double d = make(rng);
+		std::string s;
+		(void)conv::float_to_str(d, s);
+		data.floats.push_back(d);
+		data.strs.push_back(s);
+		data.wstrs.push_back(widen(s));
+		data.bytes += s.size();
+	}
+	return data;
+}
+
+struct options
+{
+	size_t count = 200000;
+	const char* filter = nullptr;
+};
+
+// best of 5 runs of one op per item, and the allocations of all of them
+template<typename Items, typename Run>
+void bench(const options& opt, const char* family, const char* impl, const dataset& data, const Items& items, Run run)
+{
+	if (opt.filter && !std::strstr(family, opt.filter) && !std::strstr(impl, opt.filter) && !std::strstr(data.name, opt.filter))
+		return;
+	const int runs = 5;
+	double best = 1e300;
+	std::uint64_t sum = 0;
+	const std::uint64_t allocations_before = allocations;
+	for (int r = 0; r < runs; ++r)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (const auto& item : items)
+			sum += (std::uint64_t)run(item);
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double)items.size();
+		if (ns < best)
+			best = ns;
+	}
+	const double allocs_per_op = (double)(allocations - allocations_before) / ((double)items.size() * runs);
+	const double mb_per_s = (double)data.bytes / (double)items.size() / best * 1e3;
+	if (sum == 42)
+		std::printf("unlikely\n");
+	std::printf("%-13s %-24s %-22s %9.2f %9.1f %9.2f\n", family, impl, data.name, best, mb_per_s, allocs_per_op);
+}
+
+void bench_parse_int(const options& opt, const dataset& data)
+{
+	const int base = data.base;
+	const bool hex = base == 16;
+	const char* family = "str_to_num";
+	bench(opt, family, "conv string", data, data.strs, [base](const std::string& s) {
+		std::int64_t n = 0;
+		(void)conv::str_to_num(s, n, base);
+		return n;
+	});
+	bench(opt, family, "conv string_view", data, data.strs, [base](const std::string& s) {
+		std::int64_t n = 0;
+		(void)conv::str_to_num(std::string_view(s), n, base);
+		return n;
+	});
+	bench(opt, family, "conv char*", data, data.strs, [base](const std::string& s) {
+		std::int64_t n = 0;
+		(void)conv::str_to_num(s.c_str(), n, base);
+		return n;
+	});
+	// validation only, the value is not computed
+	bench(opt, family, "conv classify", data, data.strs, [](const std::string& s) {
+		return conv::classify(s).digits;
+	});
+	bench(opt, family, "conv wstring", data, data.wstrs, [base](const std::wstring& s) {
+		std::int64_t n = 0;
+		(void)conv::str_to_num(s, n, base);
+		return n;
+	});
+	bench(opt, family, "conv wchar_t*", data, data.wstrs, [base](const std::wstring& s) {
+		std::int64_t n = 0;
+		(void)conv::str_to_num(s.c_str(), n, base);
+		return n;
+	});
+	if (hex)
+	{
+		bench(opt, family, "conv str_to_num<16>", data, data.strs, [](const std::string& s) {
+			std::int64_t n = 0;
+			(void)conv::str_to_num<16>(s, n);
+			return n;
+		});
+	}
+	else
+	{
+		bench(opt, family, "conv str_to_num<10>", data, data.strs, [](const std::string& s) {
+			std::int64_t n = 0;
+			(void)conv::str_to_num<10>(s, n);
+			return n;
+		});
+	}
+	bench(opt, family, "std::from_chars", data, data.strs, [base](const std::string& s) {
+		std::int64_t n = 0;
+		std::from_chars(s.data(), s.data() + s.size(), n, base);
+		return n;
+	});
+	bench(opt, family, "strtoll", data, data.strs, [base](const std::string& s) {
+		return (std::int64_t)std::strtoll(s.c_str(), nullptr, base);
+	});
+	bench(opt, family, "wcstoll", data, data.wstrs, [base](const std::wstring& s) {
+		return (std::int64_t)std::wcstoll(s.c_str(), nullptr, base);
+	});
+	bench(opt, family, "sscanf", data, data.strs, [hex](const std::string& s) {
+		std::int64_t n = 0;
+		if (hex)
+		{
+			std::uint64_t u = 0;
+			(void)std::sscanf(s.c_str(), "%" SCNx64, &u);
+			n = (std::int64_t)u;
+		}
+		else
+			(void)std::sscanf(s.c_str(), "%" SCNd64, &n);
+		return n;
+	});
+	bench(opt, family, "std::stoll", data, data.strs, [base](const std::string& s) {
+		return (std::int64_t)std::stoll(s, nullptr, base);
+	});
+	bench(opt, family, "std::istringstream", data, data.strs, [hex](const std::string& s) {
+		std::istringstream in(s);
+		long long n = 0;
+		if (hex)
+			in >> std::hex;
+		in >> n;
+		return (std::int64_t)n;
+	});
+}
+
+void bench_format_int(const options& opt, const dataset& data)
+{
+	const int base = data.base;
+	const bool hex = base == 16;
+	const char* family = "num_to_str";
+	std::string str;
+	std::wstring wstr;
+	bench(opt, family, "conv string", data, data.ints, [base, &str](std::int64_t n) {
+		(void)conv::num_to_str(n, str, base);
+		return str.size();
+	});
+	bench(opt, family, "conv char*", data, data.ints, [base](std::int64_t n) {
+		char buf[72];
+		(void)conv::num_to_str(n, buf, sizeof(buf), base);
+		return (size_t)buf[0];
+	});
+	if (!hex)
+	{
+		bench(opt, family, "conv char* grouped", data, data.ints, [](std::int64_t n) {
+			char buf[72];
+			(void)conv::num_to_str(n, buf, sizeof(buf), conv::punctuation());
+			return (size_t)buf[0];
+		});
+	}
+	bench(opt, family, "conv wstring", data, data.ints, [base, &wstr](std::int64_t n) {
+		(void)conv::num_to_str(n, wstr, base);
+		return wstr.size();
+	});
+	bench(opt, family, "conv wchar_t*", data, data.ints, [base](std::int64_t n) {
+		wchar_t buf[72];
+		return conv::num_to_str(n, buf, 72, base) ? (size_t)buf[0] : 0;
+	});
+	bench(opt, family, "conv to_str", data, data.ints, [](std::int64_t n) {
+		return conv::to_str(n).size();
+	});
+	bench(opt, family, "conv to_str_fixed", data, data.ints, [](std::int64_t n) {
+		return conv::to_str_fixed(n).size();
+	});
+	bench(opt, family, "std::to_chars", data, data.ints, [base](std::int64_t n) {
+		char buf[72];
+		return (size_t)(std::to_chars(buf, buf + sizeof(buf), n, base).ptr - buf);
+	});
+	bench(opt, family, "snprintf", data, data.ints, [hex](std::int64_t n) {
+		char buf[72];
+		return (size_t)std::snprintf(buf, sizeof(buf), hex ? "%" PRIx64 : "%" PRId64, n);
+	});
+	if (!hex)
+	{
+		bench(opt, family, "std::to_string", data, data.ints, [](std::int64_t n) {
+			return std::to_string(n).size();
+		});
+	}
+	bench(opt, family, "std::ostringstream", data, data.ints, [hex](std::int64_t n) {
+		std::ostringstream out;
+		if (hex)
+			out << std::hex;
+		out << n;
+		return out.str().size();
+	});
+}
+
+void bench_parse_float(const options& opt, const dataset& data)
+{
+	const char* family = "str_to_float";
+	auto bits = [](double d) {
+		std::uint64_t u;
+		std::memcpy(&u, &d, sizeof(d));
+		return u;
+	};
+	bench(opt, family, "conv string", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		(void)conv::str_to_float(s, d);
+		return bits(d);
+	});
+	bench(opt, family, "conv string_view", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		(void)conv::str_to_float(std::string_view(s), d);
+		return bits(d);
+	});
+	bench(opt, family, "conv grouped", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		(void)conv::str_to_float(std::string_view(s), d, conv::punctuation());
+		return bits(d);
+	});
+	bench(opt, family, "conv char*", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		(void)conv::str_to_float(s.c_str(), d);
+		return bits(d);
+	});
+	// fixed-point prices to an int64_t in thousandths, no exponents
+	if (std::strcmp(data.name, "short decimals") == 0)
+		bench(opt, family, "conv decimal", data, data.strs, [](const std::string& s) {
+			std::int64_t scaled = 0;
+			(void)conv::str_to_decimal(std::string_view(s), scaled, 3);
+			return scaled;
+		});
+	// validation only, the value is not computed
+	bench(opt, family, "conv classify", data, data.strs, [](const std::string& s) {
+		return conv::classify(s).digits;
+	});
+	bench(opt, family, "conv wstring", data, data.wstrs, [bits](const std::wstring& s) {
+		double d = 0;
+		(void)conv::str_to_float(s, d);
+		return bits(d);
+	});
+	bench(opt, family, "conv wchar_t*", data, data.wstrs, [bits](const std::wstring& s) {
+		double d = 0;
+		(void)conv::str_to_float(s.c_str(), d);
+		return bits(d);
+	});
+#if defined(__cpp_lib_to_chars)
+	bench(opt, family, "std::from_chars", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		std::from_chars(s.data(), s.data() + s.size(), d);
+		return bits(d);
+	});
+#endif
+	bench(opt, family, "strtod", data, data.strs, [bits](const std::string& s) {
+		return bits(std::strtod(s.c_str(), nullptr));
+	});
+	bench(opt, family, "wcstod", data, data.wstrs, [bits](const std::wstring& s) {
+		return bits(std::wcstod(s.c_str(), nullptr));
+	});
+	bench(opt, family, "sscanf", data, data.strs, [bits](const std::string& s) {
+		double d = 0;
+		(void)std::sscanf(s.c_str(), "%lf", &d);
+		return bits(d);
+	});
+	bench(opt, family, "std::stod", data, data.strs, [bits](const std::string& s) {
+		return bits(std::stod(s));
+	});
+	bench(opt, family, "std::istringstream", data, data.strs, [bits](const std::string& s) {
+		std::istringstream in(s);
+		double d = 0;
+		in >> d;
+		return bits(d);
+	});
+}
+
+void bench_format_float(const options& opt, const dataset& data)
+{
+	const char* family = "float_to_str";
+	std::string str;
+	std::wstring wstr;
+	bench(opt, family, "conv string", data, data.floats, [&str](double d) {
+		(void)conv::float_to_str(d, str);
+		return str.size();
+	});
+	bench(opt, family, "conv char*", data, data.floats, [](double d) {
+		char buf[400];
+		(void)conv::float_to_str(d, buf, sizeof(buf));
+		return (size_t)buf[0];
+	});
+	bench(opt, family, "conv wstring", data, data.floats, [&wstr](double d) {
+		(void)conv::float_to_str(d, wstr);
+		return wstr.size();
+	});
+	bench(opt, family, "conv wchar_t*", data, data.floats, [](double d) {
+		wchar_t buf[400];
+		(void)conv::float_to_str(d, buf, 400);
+		return (size_t)buf[0];
+	});
+	bench(opt, family, "conv to_str_fixed", data, data.floats, [](double d) {
+		return conv::to_str_fixed(d).size();
+	});
+	if (std::strcmp(data.name, "short decimals") == 0)
+		bench(opt, family, "conv decimal", data, data.floats, [](double d) {
+			char buf[32];
+			(void)conv::decimal_to_str(std::llround(d * 1000), 3, buf, sizeof(buf));
+			return (size_t)buf[0];
+		});
+#if defined(__cpp_lib_to_chars)
+	bench(opt, family, "std::to_chars", data, data.floats, [](double d) {
+		char buf[400];
+		return (size_t)(std::to_chars(buf, buf + sizeof(buf), d).ptr - buf);
+	});
+#endif
+	bench(opt, family, "snprintf %.17g", data, data.floats, [](double d) {
+		char buf[400];
+		return (size_t)std::snprintf(buf, sizeof(buf), "%.17g", d);
+	});
+	bench(opt, family, "std::to_string (%f)", data, data.floats, [](double d) {
+		return std::to_string(d).size();
+	});
+	bench(opt, family, "std::ostringstream", data, data.floats, [](double d) {
+		std::ostringstream out;
+		out.precision(17);
+		out << d;
+		return out.str().size();
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+		{
+			if (!conv::str_to_num(argv[++i], opt.count) || opt.count == 0)
+			{
+				std::fprintf(stderr, "--count takes a positive number\n");
+				return 1;
+			}
+		}
+		else
+			opt.filter = argv[i];
+	}
+
+	std::vector<dataset> int_sets;
+	// as many numbers of each length from 1 to 18 digits
+	int_sets.push_back(make_int_dataset("uniform length", 10, opt.count, [](std::mt19937_64& rng) {
+		const std::uint64_t digits = 1 + rng() % 18;
+		std::int64_t low = 1;
+		for (std::uint64_t i = 1; i < digits; ++i)
+			low *= 10;
+		const std::int64_t n = low + (std::int64_t)(rng() % (std::uint64_t)(low * 9));
+		return (rng() & 1) ? -n : n;
+	}));
+	// mostly short numbers, ids and counts, with a long tail
+	int_sets.push_back(make_int_dataset("skewed length", 10, opt.count, [](std::mt19937_64& rng) {
+		if (rng() % 100 < 80)
+			return (std::int64_t)(rng() % 10000);
+		return (std::int64_t)(rng() >> (rng() % 63 + 1));
+	}));
+	int_sets.push_back(make_int_dataset("hex", 16, opt.count, [](std::mt19937_64& rng) {
+		return (std::int64_t)(rng() >> (rng() % 63 + 1));
+	}));
+
+	std::vector<dataset> float_sets;
+	float_sets.push_back(make_float_dataset("short decimals", opt.count, [](std::mt19937_64& rng) {
+		return (double)(rng() % 10000000) / 1000;
+	}));
+	float_sets.push_back(make_float_dataset("exponents 1e-30..30", opt.count, [](std::mt19937_64& rng) {
+		return std::uniform_real_distribution<double>(1, 10)(rng) * std::pow(10.0, (int)(rng() % 61) - 30);
+	}));
+	float_sets.push_back(make_float_dataset("exponents 1e-300..300", opt.count, [](std::mt19937_64& rng) {
+		return std::uniform_real_distribution<double>(1, 10)(rng) * std::pow(10.0, (int)(rng() % 601) - 300);
+	}));
+
+	std::printf("%-13s %-24s %-22s %9s %9s %9s\n", "family", "implementation", "dataset", "ns/op", "MB/s", "allocs/op");
+	for (const dataset& data : int_sets)
+		bench_parse_int(opt, data);
+	for (const dataset& data : float_sets)
+		bench_parse_float(opt, data);
+	for (const dataset& data : int_sets)
+		bench_format_int(opt, data);
+	for (const dataset& data : float_sets)
+		bench_format_float(opt, data);
+	return 0;
+}
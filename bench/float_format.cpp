@@ -0,0 +1,103 @@
+// Throughput of conv::float_to_str() against std::to_chars(),
+// snprintf("%.17g") and std::to_string() on seeded doubles. Build and run
+// from the repository root:
+//   g++ -std=c++17 -O2 -ITestTo bench/float_format.cpp -o float_format && ./float_format
+#include "conv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct dataset
+{
+	const char* name;
+	std::vector<double> nums;
+};
+
+template<typename Make>
+dataset make_dataset(const char* name, size_t count, Make make)
+{
+	dataset data{ name, {} };
+	std::mt19937_64 rng(12345);
+	for (size_t i = 0; i < count; ++i)
+		data.nums.push_back(make(rng));
+	return data;
+}
+
+// best of 5 runs, in ns per number
+template<typename Format>
+double time_format(const dataset& data, Format format)
+{
+	double best = 1e300;
+	for (int run = 0; run < 5; ++run)
+	{
+		size_t bytes = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (double d : data.nums)
+			bytes += format(d);
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double)data.nums.size();
+		if (bytes == 42)
+			std::printf("unlikely\n");
+		if (ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+void report(const char* impl, const dataset& data, double ns)
+{
+	std::printf("%-22s %-16s %8.2f ns/number\n", impl, data.name, ns);
+}
+
+int main()
+{
+	const size_t count = 500000;
+	std::vector<dataset> sets;
+	sets.push_back(make_dataset("short 12.345", count, [](std::mt19937_64& rng) {
+		return (double)(rng() % 100000000) / 1000;
+	}));
+	sets.push_back(make_dataset("uniform [0,1)", count, [](std::mt19937_64& rng) {
+		return std::uniform_real_distribution<double>(0, 1)(rng);
+	}));
+	sets.push_back(make_dataset("random bits", count, [](std::mt19937_64& rng) {
+		double d;
+		do
+		{
+			const std::uint64_t bits = rng();
+			std::memcpy(&d, &bits, sizeof(d));
+		} while (d != d || d - d != 0);
+		return d;
+	}));
+
+	for (const dataset& data : sets)
+	{
+		report("conv char[32]", data, time_format(data, [](double d) {
+			char buf[32];
+			(void)conv::float_to_str(d, buf, sizeof(buf));
+			return strlen(buf);
+		}));
+		report("conv std::string", data, time_format(data, [](double d) {
+			std::string str;
+			(void)conv::float_to_str(d, str);
+			return str.size();
+		}));
+#if defined(__cpp_lib_to_chars)
+		report("to_chars", data, time_format(data, [](double d) {
+			char buf[32];
+			return (size_t)(std::to_chars(buf, buf + sizeof(buf), d).ptr - buf);
+		}));
+#endif
+		report("snprintf(\"%.17g\")", data, time_format(data, [](double d) {
+			char buf[32];
+			return (size_t)std::snprintf(buf, sizeof(buf), "%.17g", d);
+		}));
+		report("std::to_string", data, time_format(data, [](double d) {
+			return std::to_string(d).size();
+		}));
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+// Throughput of conv::str_to_float() against std::from_chars() on seeded
+// float text. Build and run from the repository root:
+//   g++ -std=c++17 -O2 -ITestTo bench/float_parse.cpp -o float_parse && ./float_parse
+#include "conv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct dataset
+{
+	const char* name;
+	std::vector<std::string> strs;
+	size_t bytes = 0;
+};
+
+template<typename Make>
+dataset make_dataset(const char* name, size_t count, Make make)
+{
+	dataset data{ name, {} };
+	std::mt19937_64 rng(12345);
+	char buf[64];
+	for (size_t i = 0; i < count; ++i)
+	{
+		make(rng, buf, sizeof(buf));
+		data.strs.emplace_back(buf);
+		data.bytes += data.strs.back().size();
+	}
+	return data;
+}
+
+// best of 5 runs, in ns per number
+template<typename Parse>
+double time_parse(const dataset& data, Parse parse)
+{
+	double best = 1e300;
+	for (int run = 0; run < 5; ++run)
+	{
+		double sum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (const std::string& s : data.strs)
+			sum += parse(s);
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double)data.strs.size();
+		if (sum == 42.4242)
+			std::printf("unlikely\n");
+		if (ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+void report(const char* impl, const dataset& data, double ns)
+{
+	const double mb_per_s = (double)data.bytes / (double)data.strs.size() / ns * 1e3;
+	std::printf("%-12s %-22s %8.2f ns/number %9.1f MB/s\n", impl, data.name, ns, mb_per_s);
+}
+
+int main()
+{
+	const size_t count = 500000;
+	std::vector<dataset> sets;
+	sets.push_back(make_dataset("short \"12.345\"", count, [](std::mt19937_64& rng, char* buf, size_t len) {
+		std::snprintf(buf, len, "%u.%03u", (unsigned)(rng() % 100000), (unsigned)(rng() % 1000));
+	}));
+	sets.push_back(make_dataset("uniform [0,1) %.17g", count, [](std::mt19937_64& rng, char* buf, size_t len) {
+		std::snprintf(buf, len, "%.17g", std::uniform_real_distribution<double>(0, 1)(rng));
+	}));
+	sets.push_back(make_dataset("random bits %.17g", count, [](std::mt19937_64& rng, char* buf, size_t len) {
+		double d;
+		do
+		{
+			const std::uint64_t bits = rng();
+			std::memcpy(&d, &bits, sizeof(d));
+		} while (d != d || d - d != 0);
+		std::snprintf(buf, len, "%.17g", d);
+	}));
+
+	for (const dataset& data : sets)
+	{
+		report("conv", data, time_parse(data, [](const std::string& s) {
+			double d = 0;
+			(void)conv::str_to_float(s, d);
+			return d;
+		}));
+#if defined(__cpp_lib_to_chars)
+		report("from_chars", data, time_parse(data, [](const std::string& s) {
+			double d = 0;
+			std::from_chars(s.data(), s.data() + s.size(), d);
+			return d;
+		}));
+#endif
+		report("strtod", data, time_parse(data, [](const std::string& s) {
+			return std::strtod(s.c_str(), nullptr);
+		}));
+	}
+	return 0;
+}
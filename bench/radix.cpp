@@ -0,0 +1,114 @@
+// Throughput of the power of two bases in conv::num_to_str() and
+// conv::str_to_num() against std::to_chars(), std::from_chars(), snprintf()
+// and strtoull() on seeded 64 bit values. Build and run from the repository
+// root:
+//   g++ -std=c++17 -O2 -ITestTo bench/radix.cpp -o radix && ./radix
+#include "conv.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct dataset
+{
+	const char* name;
+	int base;
+	std::vector<std::uint64_t> nums;
+	std::vector<std::string> strs;
+};
+
+dataset make_dataset(const char* name, int base, size_t count, int max_shift)
+{
+	dataset data{ name, base, {}, {} };
+	std::mt19937_64 rng(12345);
+	char buf[72];
+	for (size_t i = 0; i < count; ++i)
+	{
+		const std::uint64_t n = rng() >> (rng() % (max_shift + 1));
+		data.nums.push_back(n);
+		*std::to_chars(buf, buf + sizeof(buf), n, base).ptr = '\0';
+		data.strs.emplace_back(buf);
+	}
+	return data;
+}
+
+// best of 5 runs, in ns per number
+template<typename Items, typename Run>
+double time_run(const Items& items, Run run)
+{
+	double best = 1e300;
+	for (int r = 0; r < 5; ++r)
+	{
+		std::uint64_t sum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (const auto& item : items)
+			sum += run(item);
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (double)items.size();
+		if (sum == 42)
+			std::printf("unlikely\n");
+		if (ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+void report(const char* impl, const dataset& data, double ns)
+{
+	std::printf("%-18s %-24s %8.2f ns/number\n", impl, data.name, ns);
+}
+
+int main()
+{
+	const size_t count = 500000;
+	std::vector<dataset> sets;
+	sets.push_back(make_dataset("base 2, 64 bit", 2, count, 0));
+	sets.push_back(make_dataset("base 8, 64 bit", 8, count, 0));
+	sets.push_back(make_dataset("base 16, 64 bit", 16, count, 0));
+	sets.push_back(make_dataset("base 16, mixed length", 16, count, 63));
+	sets.push_back(make_dataset("base 32, 64 bit", 32, count, 0));
+
+	for (const dataset& data : sets)
+	{
+		const int base = data.base;
+		report("conv num_to_str", data, time_run(data.nums, [base](std::uint64_t n) {
+			char buf[72];
+			(void)conv::num_to_str(n, buf, sizeof(buf), base);
+			return (std::uint64_t)buf[0];
+		}));
+#if defined(__cpp_lib_to_chars)
+		report("to_chars", data, time_run(data.nums, [base](std::uint64_t n) {
+			char buf[72];
+			return (std::uint64_t)(std::to_chars(buf, buf + sizeof(buf), n, base).ptr - buf);
+		}));
+#endif
+		if (base == 8 || base == 16)
+		{
+			report("snprintf", data, time_run(data.nums, [base](std::uint64_t n) {
+				char buf[72];
+				return (std::uint64_t)std::snprintf(buf, sizeof(buf), base == 8 ? "%" PRIo64 : "%" PRIx64, n);
+			}));
+		}
+		report("conv str_to_num", data, time_run(data.strs, [base](const std::string& s) {
+			std::uint64_t n = 0;
+			(void)conv::str_to_num(s, n, base);
+			return n;
+		}));
+#if defined(__cpp_lib_to_chars)
+		report("from_chars", data, time_run(data.strs, [base](const std::string& s) {
+			std::uint64_t n = 0;
+			std::from_chars(s.data(), s.data() + s.size(), n, base);
+			return n;
+		}));
+#endif
+		report("strtoull", data, time_run(data.strs, [base](const std::string& s) {
+			return (std::uint64_t)std::strtoull(s.c_str(), nullptr, base);
+		}));
+	}
+	return 0;
+}